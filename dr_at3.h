@@ -50,6 +50,12 @@
  *
  *   #define DR_AT3_NO_STDIO
  *     Disables file I/O APIs (drat3_init_file, drat3_open_file_and_read_pcm_frames_*).
+ *
+ *   #define DR_AT3_MULTITHREADED_DECODE
+ *     Enables multithreaded decoding in the drat3_open_*_and_read_pcm_frames_* APIs. Each worker
+ *     thread decodes a disjoint range of encoded frames with its own decoder instance. Output may
+ *     differ very slightly from the single-threaded path at partition boundaries (same tolerance
+ *     as seeking). Requires pthreads or Win32 threads; falls back to serial decoding otherwise.
  */
 
 #ifndef DR_AT3_H
@@ -222,6 +228,7 @@ typedef struct drat3 {
     drat3_uint32 decodeBufferCapacity;  /* In PCM frames */
     drat3_uint32 leftoverFrames;        /* Leftover frames from previous decode */
     drat3_uint32 leftoverOffset;        /* Offset into decode buffer */
+    drat3_uint64 (* readProcF32)(struct drat3* pAt3, drat3_uint64 framesToRead, float* pBufferOut);    /* Mono/stereo specialized reader, chosen at init. */
     drat3_allocation_callbacks allocationCallbacks;
 } drat3;
 
@@ -7914,6 +7921,51 @@ static void drat3__free(void* p, const drat3_allocation_callbacks* pAlloc) {
     free(p);
 }
 
+/*
+Non-temporal copy support. The bulk open_and_read APIs fill an output buffer that the caller
+typically consumes linearly well after the decode loop has finished, so there is no benefit
+in pulling those cache lines in just to write them. Streaming stores keep the decoder's
+working set (transform state, window overlap) resident in cache instead. Falls back to a
+plain memcpy for small or unaligned copies, and on compilers/architectures without SSE.
+*/
+#if !defined(DR_AT3_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2))
+    #define DRAT3_SUPPORT_SSE2
+    #define DRAT3_SUPPORT_NT_STORES
+    #include <emmintrin.h>
+#endif
+
+#define DRAT3_NT_COPY_THRESHOLD 8192    /* In bytes. Below this a cached copy is cheaper than the fence. */
+
+static void drat3__memcpy_nt(void* pDst, const void* pSrc, size_t sizeInBytes) {
+#if defined(DRAT3_SUPPORT_NT_STORES)
+    if (sizeInBytes >= DRAT3_NT_COPY_THRESHOLD && (((uintptr_t)pDst | (uintptr_t)pSrc) & 15) == 0) {
+        float* dst = (float*)pDst;
+        const float* src = (const float*)pSrc;
+        while (sizeInBytes >= 64) {
+            _mm_stream_ps(dst +  0, _mm_load_ps(src +  0));
+            _mm_stream_ps(dst +  4, _mm_load_ps(src +  4));
+            _mm_stream_ps(dst +  8, _mm_load_ps(src +  8));
+            _mm_stream_ps(dst + 12, _mm_load_ps(src + 12));
+            dst += 16;
+            src += 16;
+            sizeInBytes -= 64;
+        }
+        while (sizeInBytes >= 16) {
+            _mm_stream_ps(dst, _mm_load_ps(src));
+            dst += 4;
+            src += 4;
+            sizeInBytes -= 16;
+        }
+        if (sizeInBytes > 0) {
+            memcpy(dst, src, sizeInBytes);
+        }
+        _mm_sfence();   /* Make the streamed data visible before the buffer is handed back. */
+        return;
+    }
+#endif
+    memcpy(pDst, pSrc, sizeInBytes);
+}
+
 /* Float to int16 conversion */
 static drat3_int16 drat3__f32_to_s16(float x) {
     x = x * 32767.0f;
@@ -7922,6 +7974,166 @@ static drat3_int16 drat3__f32_to_s16(float x) {
     return (drat3_int16)x;
 }
 
+/* Contiguous f32 -> s16 conversion. The SSE2 path truncates and saturates exactly like the scalar helper. */
+static void drat3__f32_to_s16_array(drat3_int16* pDst, const float* pSrc, size_t count) {
+    size_t i = 0;
+
+#if defined(DRAT3_SUPPORT_SSE2)
+    {
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= count; i += 8) {
+            __m128i lo = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrc + i + 0), scale));
+            __m128i hi = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrc + i + 4), scale));
+            _mm_storeu_si128((__m128i*)(pDst + i), _mm_packs_epi32(lo, hi));
+        }
+    }
+#endif
+
+    for (; i < count; i += 1) {
+        pDst[i] = drat3__f32_to_s16(pSrc[i]);
+    }
+}
+
+/*
+Fused planar f32 -> interleaved s16 for stereo. Reads the two decoder output planes and emits
+interleaved s16 in a single pass, so the s16 read path never materializes an interleaved f32
+copy of the frame.
+*/
+static void drat3__planar_f32_to_interleaved_s16_stereo(drat3_int16* pDst, const float* pSrcL, const float* pSrcR, size_t frameCount) {
+    size_t i = 0;
+
+#if defined(DRAT3_SUPPORT_SSE2)
+    {
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= frameCount; i += 8) {
+            __m128i l0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrcL + i + 0), scale));
+            __m128i l1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrcL + i + 4), scale));
+            __m128i r0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrcR + i + 0), scale));
+            __m128i r1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pSrcR + i + 4), scale));
+            __m128i l  = _mm_packs_epi32(l0, l1);
+            __m128i r  = _mm_packs_epi32(r0, r1);
+            _mm_storeu_si128((__m128i*)(pDst + i*2 + 0), _mm_unpacklo_epi16(l, r));
+            _mm_storeu_si128((__m128i*)(pDst + i*2 + 8), _mm_unpackhi_epi16(l, r));
+        }
+    }
+#endif
+
+    for (; i < frameCount; i += 1) {
+        pDst[i*2 + 0] = drat3__f32_to_s16(pSrcL[i]);
+        pDst[i*2 + 1] = drat3__f32_to_s16(pSrcR[i]);
+    }
+}
+
+/*
+Specialized f32 readers. The body is instantiated once for mono and once for stereo so that
+CHANNELS is a literal inside each expansion: the compiler folds the frame-size multiplies,
+drops the interleave entirely for mono, and unrolls it for stereo. drat3_read_pcm_frames_f32
+dispatches through pAt3->readProcF32, which drat3__init_internal points at the right variant.
+*/
+#define DRAT3_READ_PCM_FRAMES_F32_IMPL(name, CHANNELS) \
+static drat3_uint64 name(drat3* pAt3, drat3_uint64 framesToRead, float* pBufferOut) { \
+    drat3_uint64 totalFramesRead = 0; \
+    \
+    /* First, consume any leftover frames from previous decode */ \
+    if (pAt3->leftoverFrames > 0) { \
+        drat3_uint64 framesToConsume = pAt3->leftoverFrames; \
+        if (framesToConsume > framesToRead) { \
+            framesToConsume = framesToRead; \
+        } \
+        \
+        if (pBufferOut != NULL) { \
+            drat3__memcpy_nt(pBufferOut, \
+                   pAt3->pDecodeBuffer + pAt3->leftoverOffset * (CHANNELS), \
+                   (size_t)(framesToConsume * (CHANNELS) * sizeof(float))); \
+            pBufferOut += framesToConsume * (CHANNELS); \
+        } \
+        \
+        pAt3->leftoverOffset += (drat3_uint32)framesToConsume; \
+        pAt3->leftoverFrames -= (drat3_uint32)framesToConsume; \
+        pAt3->currentPCMFrame += framesToConsume; \
+        totalFramesRead += framesToConsume; \
+        framesToRead -= framesToConsume; \
+    } \
+    \
+    /* Decode more frames as needed */ \
+    while (framesToRead > 0) { \
+        int bytesRead; \
+        int nbSamples = 0; \
+        float* outPtrs[2]; \
+        drat3_uint32 i; \
+        \
+        /* Read next encoded frame */ \
+        bytesRead = drat3_container_read_frame(pAt3->pContainer, pAt3->pFrameBuffer, pAt3->frameBufferSize); \
+        if (bytesRead <= 0) { \
+            break; /* End of stream or error */ \
+        } \
+        \
+        /* Decode the frame. For stereo the planes live after the interleaved region so the interleave below does not overwrite samples it has not yet read. */ \
+        outPtrs[0] = pAt3->pDecodeBuffer + ((CHANNELS) == 2 ? 2 * pAt3->decodeBufferCapacity : 0); \
+        outPtrs[1] = outPtrs[0] + pAt3->decodeBufferCapacity; \
+        \
+        if (pAt3->codecType == DRAT3_CODEC_ATRAC3) { \
+            if (atrac3_decode_frame((struct ATRAC3Context*)pAt3->pDecoder, outPtrs, &nbSamples, pAt3->pFrameBuffer, bytesRead) < 0) { \
+                break; \
+            } \
+        } else { \
+            if (atrac3p_decode_frame((struct ATRAC3PContext*)pAt3->pDecoder, outPtrs, &nbSamples, pAt3->pFrameBuffer, bytesRead) < 0) { \
+                break; \
+            } \
+        } \
+        \
+        if (nbSamples <= 0) { \
+            continue; \
+        } \
+        \
+        /* Interleave the output (decoder outputs planar). For mono, data is already in place. */ \
+        if ((CHANNELS) == 2) { \
+            float* dst = pAt3->pDecodeBuffer; \
+            float* src0 = outPtrs[0]; \
+            float* src1 = outPtrs[1]; \
+            for (i = 0; i < (drat3_uint32)nbSamples; i++) { \
+                float s0 = src0[i]; \
+                float s1 = src1[i]; \
+                dst[i * 2 + 0] = s0; \
+                dst[i * 2 + 1] = s1; \
+            } \
+        } \
+        \
+        /* How many frames can we deliver now? */ \
+        { \
+            drat3_uint64 framesToDeliver = (drat3_uint32)nbSamples; \
+            if (framesToDeliver > framesToRead) { \
+                framesToDeliver = framesToRead; \
+            } \
+            \
+            if (pBufferOut != NULL) { \
+                drat3__memcpy_nt(pBufferOut, pAt3->pDecodeBuffer, (size_t)(framesToDeliver * (CHANNELS) * sizeof(float))); \
+                pBufferOut += framesToDeliver * (CHANNELS); \
+            } \
+            \
+            pAt3->currentPCMFrame += framesToDeliver; \
+            totalFramesRead += framesToDeliver; \
+            framesToRead -= framesToDeliver; \
+            \
+            /* Store leftovers */ \
+            if ((drat3_uint32)nbSamples > framesToDeliver) { \
+                pAt3->leftoverFrames = (drat3_uint32)nbSamples - (drat3_uint32)framesToDeliver; \
+                pAt3->leftoverOffset = (drat3_uint32)framesToDeliver; \
+            } else { \
+                pAt3->leftoverFrames = 0; \
+                pAt3->leftoverOffset = 0; \
+            } \
+        } \
+    } \
+    \
+    return totalFramesRead; \
+}
+
+DRAT3_READ_PCM_FRAMES_F32_IMPL(drat3__read_pcm_frames_f32__mono,   1)
+DRAT3_READ_PCM_FRAMES_F32_IMPL(drat3__read_pcm_frames_f32__stereo, 2)
+
+#undef DRAT3_READ_PCM_FRAMES_F32_IMPL
+
 /* Internal init helper */
 static drat3_result drat3__init_internal(drat3* pAt3, drat3_container* pContainer, const drat3_config* pConfig) {
     const drat3_container_info* pInfo;
@@ -7958,9 +8170,21 @@ static drat3_result drat3__init_internal(drat3* pAt3, drat3_container* pContaine
         return DRAT3_OUT_OF_MEMORY;
     }
     
-    /* Allocate decode buffer (enough for one frame, interleaved) */
+    /* The decoder only ever outputs one or two channels. */
+    if (pAt3->channels != 1 && pAt3->channels != 2) {
+        drat3__free(pAt3->pFrameBuffer, &pAt3->allocationCallbacks);
+        drat3_container_close(pContainer);
+        return DRAT3_INVALID_FILE;
+    }
+
+    pAt3->readProcF32 = (pAt3->channels == 2) ? drat3__read_pcm_frames_f32__stereo : drat3__read_pcm_frames_f32__mono;
+
+    /*
+    Allocate decode buffer (enough for one frame, interleaved). For stereo it additionally
+    holds the two planar decode planes after the interleaved region.
+    */
     pAt3->decodeBufferCapacity = pInfo->samples_per_frame;
-    pAt3->pDecodeBuffer = (float*)drat3__malloc(pAt3->decodeBufferCapacity * pAt3->channels * sizeof(float), &pAt3->allocationCallbacks);
+    pAt3->pDecodeBuffer = (float*)drat3__malloc(pAt3->decodeBufferCapacity * pAt3->channels * sizeof(float) * (pAt3->channels == 2 ? 2 : 1), &pAt3->allocationCallbacks);
     if (pAt3->pDecodeBuffer == NULL) {
         drat3__free(pAt3->pFrameBuffer, &pAt3->allocationCallbacks);
         drat3_container_close(pContainer);
@@ -8046,50 +8270,61 @@ void drat3_uninit(drat3* pAt3) {
 }
 
 drat3_uint64 drat3_read_pcm_frames_f32(drat3* pAt3, drat3_uint64 framesToRead, float* pBufferOut) {
+    if (pAt3 == NULL || framesToRead == 0 || pAt3->readProcF32 == NULL) {
+        return 0;
+    }
+
+    return pAt3->readProcF32(pAt3, framesToRead, pBufferOut);
+}
+
+drat3_uint64 drat3_read_pcm_frames_s16(drat3* pAt3, drat3_uint64 framesToRead, drat3_int16* pBufferOut) {
     drat3_uint64 totalFramesRead = 0;
-    
-    if (pAt3 == NULL || framesToRead == 0) {
+
+    if (pAt3 == NULL || framesToRead == 0 || pAt3->readProcF32 == NULL) {
         return 0;
     }
-    
-    /* First, consume any leftover frames from previous decode */
+
+    /* First, consume any leftover frames from a previous decode. These are interleaved f32 in the decode buffer. */
     if (pAt3->leftoverFrames > 0) {
         drat3_uint64 framesToConsume = pAt3->leftoverFrames;
         if (framesToConsume > framesToRead) {
             framesToConsume = framesToRead;
         }
-        
+
         if (pBufferOut != NULL) {
-            memcpy(pBufferOut, 
+            drat3__f32_to_s16_array(pBufferOut,
                    pAt3->pDecodeBuffer + pAt3->leftoverOffset * pAt3->channels,
-                   (size_t)(framesToConsume * pAt3->channels * sizeof(float)));
+                   (size_t)(framesToConsume * pAt3->channels));
             pBufferOut += framesToConsume * pAt3->channels;
         }
-        
+
         pAt3->leftoverOffset += (drat3_uint32)framesToConsume;
         pAt3->leftoverFrames -= (drat3_uint32)framesToConsume;
         pAt3->currentPCMFrame += framesToConsume;
         totalFramesRead += framesToConsume;
         framesToRead -= framesToConsume;
     }
-    
-    /* Decode more frames as needed */
+
+    /*
+    Decode whole frames straight from the planar decoder output into the caller's buffer.
+    This is a single fused pass: no interleaved f32 staging and no temp buffer. Only a
+    partially-delivered frame takes the interleave detour so the remainder can be kept as
+    interleaved f32 leftovers (they may be consumed by either the f32 or s16 reader next).
+    */
     while (framesToRead > 0) {
         int bytesRead;
         int nbSamples = 0;
         float* outPtrs[2];
         drat3_uint32 i;
-        
-        /* Read next encoded frame */
+
         bytesRead = drat3_container_read_frame(pAt3->pContainer, pAt3->pFrameBuffer, pAt3->frameBufferSize);
         if (bytesRead <= 0) {
             break; /* End of stream or error */
         }
-        
-        /* Decode the frame */
-        outPtrs[0] = pAt3->pDecodeBuffer;
-        outPtrs[1] = pAt3->pDecodeBuffer + pAt3->decodeBufferCapacity;
-        
+
+        outPtrs[0] = pAt3->pDecodeBuffer + (pAt3->channels == 2 ? 2 * pAt3->decodeBufferCapacity : 0);
+        outPtrs[1] = outPtrs[0] + pAt3->decodeBufferCapacity;
+
         if (pAt3->codecType == DRAT3_CODEC_ATRAC3) {
             if (atrac3_decode_frame((struct ATRAC3Context*)pAt3->pDecoder, outPtrs, &nbSamples, pAt3->pFrameBuffer, bytesRead) < 0) {
                 break;
@@ -8099,95 +8334,56 @@ drat3_uint64 drat3_read_pcm_frames_f32(drat3* pAt3, drat3_uint64 framesToRead, f
                 break;
             }
         }
-        
+
         if (nbSamples <= 0) {
             continue;
         }
-        
-        /* Interleave the output (decoder outputs planar) */
-        if (pAt3->channels == 2) {
-            float* dst = pAt3->pDecodeBuffer;
-            float* src0 = outPtrs[0];
-            float* src1 = outPtrs[1];
-            /* We need a temp buffer since we're interleaving in-place */
-            for (i = 0; i < (drat3_uint32)nbSamples; i++) {
-                float s0 = src0[i];
-                float s1 = src1[i];
-                dst[i * 2 + 0] = s0;
-                dst[i * 2 + 1] = s1;
+
+        if ((drat3_uint64)(drat3_uint32)nbSamples <= framesToRead) {
+            /* The whole frame is delivered: quantize directly from the planes. */
+            if (pBufferOut != NULL) {
+                if (pAt3->channels == 2) {
+                    drat3__planar_f32_to_interleaved_s16_stereo(pBufferOut, outPtrs[0], outPtrs[1], (size_t)nbSamples);
+                } else {
+                    drat3__f32_to_s16_array(pBufferOut, outPtrs[0], (size_t)nbSamples);
+                }
+                pBufferOut += (drat3_uint32)nbSamples * pAt3->channels;
             }
-        }
-        /* For mono, data is already in place */
-        
-        /* How many frames can we deliver now? */
-        {
-            drat3_uint64 framesToDeliver = (drat3_uint32)nbSamples;
-            if (framesToDeliver > framesToRead) {
-                framesToDeliver = framesToRead;
+
+            pAt3->currentPCMFrame += (drat3_uint32)nbSamples;
+            totalFramesRead += (drat3_uint32)nbSamples;
+            framesToRead -= (drat3_uint32)nbSamples;
+            pAt3->leftoverFrames = 0;
+            pAt3->leftoverOffset = 0;
+        } else {
+            /* Partial delivery: interleave into the decode buffer so the remainder survives as f32 leftovers. */
+            drat3_uint64 framesToDeliver = framesToRead;
+
+            if (pAt3->channels == 2) {
+                float* dst = pAt3->pDecodeBuffer;
+                const float* src0 = outPtrs[0];
+                const float* src1 = outPtrs[1];
+                for (i = 0; i < (drat3_uint32)nbSamples; i++) {
+                    dst[i * 2 + 0] = src0[i];
+                    dst[i * 2 + 1] = src1[i];
+                }
             }
-            
+            /* For mono, data is already in place. */
+
             if (pBufferOut != NULL) {
-                memcpy(pBufferOut, pAt3->pDecodeBuffer, (size_t)(framesToDeliver * pAt3->channels * sizeof(float)));
+                drat3__f32_to_s16_array(pBufferOut, pAt3->pDecodeBuffer, (size_t)(framesToDeliver * pAt3->channels));
                 pBufferOut += framesToDeliver * pAt3->channels;
             }
-            
+
             pAt3->currentPCMFrame += framesToDeliver;
             totalFramesRead += framesToDeliver;
             framesToRead -= framesToDeliver;
-            
-            /* Store leftovers */
-            if ((drat3_uint32)nbSamples > framesToDeliver) {
-                pAt3->leftoverFrames = (drat3_uint32)nbSamples - (drat3_uint32)framesToDeliver;
-                pAt3->leftoverOffset = (drat3_uint32)framesToDeliver;
-            } else {
-                pAt3->leftoverFrames = 0;
-                pAt3->leftoverOffset = 0;
-            }
-        }
-    }
-    
-    return totalFramesRead;
-}
 
-drat3_uint64 drat3_read_pcm_frames_s16(drat3* pAt3, drat3_uint64 framesToRead, drat3_int16* pBufferOut) {
-    drat3_uint64 totalFramesRead = 0;
-    float tempBuffer[2048];
-    drat3_uint64 tempFrames = sizeof(tempBuffer) / sizeof(float) / 2; /* Assume max 2 channels */
-    
-    if (pAt3 == NULL || framesToRead == 0) {
-        return 0;
-    }
-    
-    if (pAt3->channels > 0) {
-        tempFrames = sizeof(tempBuffer) / sizeof(float) / pAt3->channels;
-    }
-    
-    while (framesToRead > 0) {
-        drat3_uint64 framesToReadNow = framesToRead;
-        drat3_uint64 framesRead;
-        drat3_uint64 i;
-        
-        if (framesToReadNow > tempFrames) {
-            framesToReadNow = tempFrames;
-        }
-        
-        framesRead = drat3_read_pcm_frames_f32(pAt3, framesToReadNow, tempBuffer);
-        if (framesRead == 0) {
-            break;
+            pAt3->leftoverFrames = (drat3_uint32)nbSamples - (drat3_uint32)framesToDeliver;
+            pAt3->leftoverOffset = (drat3_uint32)framesToDeliver;
         }
-        
-        /* Convert to s16 */
-        if (pBufferOut != NULL) {
-            for (i = 0; i < framesRead * pAt3->channels; i++) {
-                pBufferOut[i] = drat3__f32_to_s16(tempBuffer[i]);
-            }
-            pBufferOut += framesRead * pAt3->channels;
-        }
-        
-        totalFramesRead += framesRead;
-        framesToRead -= framesRead;
     }
-    
+
     return totalFramesRead;
 }
 
@@ -8257,150 +8453,306 @@ drat3_uint64 drat3_get_length_in_pcm_frames(drat3* pAt3) {
  * High-Level API Implementation
  */
 
-#ifndef DR_AT3_NO_STDIO
-float* drat3_open_file_and_read_pcm_frames_f32(const char* pFilePath, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+#if defined(DR_AT3_MULTITHREADED_DECODE)
+    #if defined(_WIN32)
+        #include <windows.h>
+        #define DRAT3_SUPPORT_THREADING
+    #elif defined(__unix__) || defined(__APPLE__)
+        #include <pthread.h>
+        #include <unistd.h>
+        #define DRAT3_SUPPORT_THREADING
+    #endif
+#endif
+
+#if defined(DRAT3_SUPPORT_THREADING)
+#define DRAT3_MT_MAX_THREADS            8
+#define DRAT3_MT_MIN_FRAMES_PER_THREAD  16  /* Encoded frames. Below this the spawn cost dominates. */
+
+/*
+Whole-file decoding is parallel at the encoded-frame level: every worker gets its own decoder
+instance and a disjoint, frame-aligned range of the stream. ATRAC3/3+ frames carry no state
+across frames other than the transform window overlap, so each worker pre-rolls one encoded
+frame before its range to settle the overlap, the same way seeking does.
+*/
+typedef struct {
+    const char* pFilePath;      /* Non-NULL for file-backed sources. */
+    const void* pData;          /* Non-NULL for memory-backed sources. */
+    size_t dataSize;
+    const drat3_allocation_callbacks* pAllocationCallbacks;
+    drat3_uint64 firstPCMFrame; /* Aligned to an encoded frame boundary. */
+    drat3_uint64 pcmFrameCount;
+    drat3_uint32 samplesPerFrame;
+    void* pDst;                 /* This worker's slice of the output buffer. */
+    drat3_bool32 outputS16;
+    drat3_uint64 framesRead;
+} drat3__mt_job;
+
+static void drat3__mt_decode_job(drat3__mt_job* pJob) {
     drat3 at3;
     drat3_config config;
-    float* pSampleData;
-    drat3_uint64 totalFramesRead;
-    
-    if (pChannels) *pChannels = 0;
-    if (pSampleRate) *pSampleRate = 0;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = 0;
-    
+    drat3_result result;
+
     memset(&config, 0, sizeof(config));
-    if (pAllocationCallbacks) {
-        config.allocationCallbacks = *pAllocationCallbacks;
+    if (pJob->pAllocationCallbacks) {
+        config.allocationCallbacks = *pJob->pAllocationCallbacks;
     }
-    
-    if (drat3_init_file(pFilePath, &config, &at3) != DRAT3_SUCCESS) {
-        return NULL;
+
+#ifndef DR_AT3_NO_STDIO
+    if (pJob->pFilePath != NULL) {
+        result = drat3_init_file(pJob->pFilePath, &config, &at3);
+    } else
+#endif
+    {
+        result = drat3_init_memory(pJob->pData, pJob->dataSize, &config, &at3);
     }
-    
-    pSampleData = (float*)drat3__malloc((size_t)(at3.totalPCMFrameCount * at3.channels * sizeof(float)), pAllocationCallbacks);
-    if (pSampleData == NULL) {
-        drat3_uninit(&at3);
-        return NULL;
+
+    if (result != DRAT3_SUCCESS) {
+        pJob->framesRead = 0;
+        return;
     }
-    
-    totalFramesRead = drat3_read_pcm_frames_f32(&at3, at3.totalPCMFrameCount, pSampleData);
-    
-    if (pChannels) *pChannels = at3.channels;
-    if (pSampleRate) *pSampleRate = at3.sampleRate;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = totalFramesRead;
-    
+
+    /* Pre-roll one encoded frame ahead of the range to warm the window overlap, then discard it. */
+    if (pJob->firstPCMFrame > 0) {
+        drat3_uint64 prerollStart = pJob->firstPCMFrame - pJob->samplesPerFrame;
+        if (drat3_seek_to_pcm_frame(&at3, prerollStart) != DRAT3_SUCCESS) {
+            drat3_uninit(&at3);
+            pJob->framesRead = 0;
+            return;
+        }
+        drat3_read_pcm_frames_f32(&at3, pJob->samplesPerFrame, NULL);
+    }
+
+    if (pJob->outputS16) {
+        pJob->framesRead = drat3_read_pcm_frames_s16(&at3, pJob->pcmFrameCount, (drat3_int16*)pJob->pDst);
+    } else {
+        pJob->framesRead = drat3_read_pcm_frames_f32(&at3, pJob->pcmFrameCount, (float*)pJob->pDst);
+    }
+
     drat3_uninit(&at3);
-    
-    return pSampleData;
 }
 
-drat3_int16* drat3_open_file_and_read_pcm_frames_s16(const char* pFilePath, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
-    drat3 at3;
-    drat3_config config;
-    drat3_int16* pSampleData;
+#if defined(_WIN32)
+static DWORD WINAPI drat3__mt_thread_entry(LPVOID pUserData) {
+    drat3__mt_decode_job((drat3__mt_job*)pUserData);
+    return 0;
+}
+#else
+static void* drat3__mt_thread_entry(void* pUserData) {
+    drat3__mt_decode_job((drat3__mt_job*)pUserData);
+    return NULL;
+}
+#endif
+
+static drat3_uint32 drat3__mt_cpu_count(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (drat3_uint32)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (drat3_uint32)n : 1;
+#endif
+}
+
+/* Returns the number of PCM frames decoded, or 0 if the stream could not be parallelized (caller falls back to serial). */
+static drat3_uint64 drat3__read_all_pcm_frames_mt(const char* pFilePath, const void* pData, size_t dataSize, const drat3* pAt3, void* pSampleData, drat3_bool32 outputS16, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    const drat3_container_info* pInfo;
+    drat3__mt_job jobs[DRAT3_MT_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE threads[DRAT3_MT_MAX_THREADS];
+#else
+    pthread_t threads[DRAT3_MT_MAX_THREADS];
+#endif
+    drat3_uint32 threadCount;
+    drat3_uint32 iThread;
+    drat3_uint64 encodedFrameCount;
+    drat3_uint64 encodedFramesPerThread;
+    drat3_uint64 nextPCMFrame;
     drat3_uint64 totalFramesRead;
-    
-    if (pChannels) *pChannels = 0;
-    if (pSampleRate) *pSampleRate = 0;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = 0;
-    
-    memset(&config, 0, sizeof(config));
-    if (pAllocationCallbacks) {
-        config.allocationCallbacks = *pAllocationCallbacks;
+    size_t bytesPerPCMFrame;
+
+    pInfo = drat3_container_get_info(pAt3->pContainer);
+    if (pInfo == NULL || pInfo->samples_per_frame == 0) {
+        return 0;
     }
-    
-    if (drat3_init_file(pFilePath, &config, &at3) != DRAT3_SUCCESS) {
-        return NULL;
+
+    encodedFrameCount = (pAt3->totalPCMFrameCount + pInfo->samples_per_frame - 1) / pInfo->samples_per_frame;
+
+    threadCount = drat3__mt_cpu_count();
+    if (threadCount > DRAT3_MT_MAX_THREADS) {
+        threadCount = DRAT3_MT_MAX_THREADS;
     }
-    
-    pSampleData = (drat3_int16*)drat3__malloc((size_t)(at3.totalPCMFrameCount * at3.channels * sizeof(drat3_int16)), pAllocationCallbacks);
-    if (pSampleData == NULL) {
-        drat3_uninit(&at3);
-        return NULL;
+    while (threadCount > 1 && encodedFrameCount / threadCount < DRAT3_MT_MIN_FRAMES_PER_THREAD) {
+        threadCount -= 1;
     }
-    
-    totalFramesRead = drat3_read_pcm_frames_s16(&at3, at3.totalPCMFrameCount, pSampleData);
-    
-    if (pChannels) *pChannels = at3.channels;
-    if (pSampleRate) *pSampleRate = at3.sampleRate;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = totalFramesRead;
-    
-    drat3_uninit(&at3);
-    
-    return pSampleData;
-}
+    if (threadCount <= 1) {
+        return 0;
+    }
+
+    bytesPerPCMFrame = pAt3->channels * (outputS16 ? sizeof(drat3_int16) : sizeof(float));
+    encodedFramesPerThread = (encodedFrameCount + threadCount - 1) / threadCount;
+    nextPCMFrame = 0;
+
+    for (iThread = 0; iThread < threadCount; iThread += 1) {
+        drat3__mt_job* pJob = &jobs[iThread];
+        drat3_uint64 pcmFrameCount = encodedFramesPerThread * pInfo->samples_per_frame;
+        if (nextPCMFrame + pcmFrameCount > pAt3->totalPCMFrameCount) {
+            pcmFrameCount = pAt3->totalPCMFrameCount - nextPCMFrame;
+        }
+
+        pJob->pFilePath = pFilePath;
+        pJob->pData = pData;
+        pJob->dataSize = dataSize;
+        pJob->pAllocationCallbacks = pAllocationCallbacks;
+        pJob->firstPCMFrame = nextPCMFrame;
+        pJob->pcmFrameCount = pcmFrameCount;
+        pJob->samplesPerFrame = pInfo->samples_per_frame;
+        pJob->pDst = (drat3_uint8*)pSampleData + nextPCMFrame * bytesPerPCMFrame;
+        pJob->outputS16 = outputS16;
+        pJob->framesRead = 0;
+
+        nextPCMFrame += pcmFrameCount;
+    }
+
+    /* Run the first range on this thread; spawn workers for the rest. */
+    for (iThread = 1; iThread < threadCount; iThread += 1) {
+#if defined(_WIN32)
+        threads[iThread] = CreateThread(NULL, 0, drat3__mt_thread_entry, &jobs[iThread], 0, NULL);
+        if (threads[iThread] == NULL) {
+            drat3_uint32 iJoin;
+            for (iJoin = 1; iJoin < iThread; iJoin += 1) {
+                WaitForSingleObject(threads[iJoin], INFINITE);
+                CloseHandle(threads[iJoin]);
+            }
+            return 0;   /* Ranges already decoded are simply redone by the serial fallback. */
+        }
+#else
+        if (pthread_create(&threads[iThread], NULL, drat3__mt_thread_entry, &jobs[iThread]) != 0) {
+            drat3_uint32 iJoin;
+            for (iJoin = 1; iJoin < iThread; iJoin += 1) {
+                pthread_join(threads[iJoin], NULL);
+            }
+            return 0;
+        }
 #endif
+    }
 
-float* drat3_open_memory_and_read_pcm_frames_f32(const void* pData, size_t dataSize, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    drat3__mt_decode_job(&jobs[0]);
+
+    /* All workers must be joined before any return below; they hold pointers into jobs[]. */
+    for (iThread = 1; iThread < threadCount; iThread += 1) {
+#if defined(_WIN32)
+        WaitForSingleObject(threads[iThread], INFINITE);
+        CloseHandle(threads[iThread]);
+#else
+        pthread_join(threads[iThread], NULL);
+#endif
+    }
+
+    /* Ranges are disjoint, so a short read in any range means the stream ended early
+       and the output is only valid up to that range's end. Job 0 is never the last
+       range here since threadCount >= 2. */
+    if (jobs[0].framesRead != jobs[0].pcmFrameCount) {
+        return jobs[0].framesRead;
+    }
+
+    totalFramesRead = jobs[0].framesRead;
+    for (iThread = 1; iThread < threadCount; iThread += 1) {
+        if (jobs[iThread].framesRead != jobs[iThread].pcmFrameCount && iThread != threadCount - 1) {
+            return jobs[iThread].firstPCMFrame + jobs[iThread].framesRead;
+        }
+        totalFramesRead += jobs[iThread].framesRead;
+    }
+
+    return totalFramesRead;
+}
+#endif  /* DRAT3_SUPPORT_THREADING */
+
+/*
+Shared worker for the four open_and_read APIs. They differ only in source (file vs memory)
+and output format, so the init/allocate/read/teardown chain lives here once and the public
+functions are thin wrappers.
+*/
+static void* drat3__open_and_read_pcm_frames(const char* pFilePath, const void* pData, size_t dataSize, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, drat3_bool32 asS16, const drat3_allocation_callbacks* pAllocationCallbacks) {
     drat3 at3;
     drat3_config config;
-    float* pSampleData;
+    void* pSampleData;
+    drat3_result result;
     drat3_uint64 totalFramesRead;
-    
+    size_t bytesPerPCMFrame;
+
     if (pChannels) *pChannels = 0;
     if (pSampleRate) *pSampleRate = 0;
     if (pTotalPCMFrameCount) *pTotalPCMFrameCount = 0;
-    
+
     memset(&config, 0, sizeof(config));
     if (pAllocationCallbacks) {
         config.allocationCallbacks = *pAllocationCallbacks;
     }
-    
-    if (drat3_init_memory(pData, dataSize, &config, &at3) != DRAT3_SUCCESS) {
+
+#ifndef DR_AT3_NO_STDIO
+    if (pFilePath != NULL) {
+        result = drat3_init_file(pFilePath, &config, &at3);
+    } else
+#endif
+    {
+        result = drat3_init_memory(pData, dataSize, &config, &at3);
+    }
+
+    if (result != DRAT3_SUCCESS) {
         return NULL;
     }
-    
-    pSampleData = (float*)drat3__malloc((size_t)(at3.totalPCMFrameCount * at3.channels * sizeof(float)), pAllocationCallbacks);
+
+    bytesPerPCMFrame = at3.channels * (asS16 ? sizeof(drat3_int16) : sizeof(float));
+    pSampleData = drat3__malloc((size_t)(at3.totalPCMFrameCount * bytesPerPCMFrame), pAllocationCallbacks);
     if (pSampleData == NULL) {
         drat3_uninit(&at3);
         return NULL;
     }
-    
-    totalFramesRead = drat3_read_pcm_frames_f32(&at3, at3.totalPCMFrameCount, pSampleData);
-    
+
+#if defined(DRAT3_SUPPORT_THREADING)
+    totalFramesRead = drat3__read_all_pcm_frames_mt(pFilePath, pData, dataSize, &at3, pSampleData, asS16, pAllocationCallbacks);
+    if (totalFramesRead == 0)
+#endif
+    {
+        if (asS16) {
+            totalFramesRead = drat3_read_pcm_frames_s16(&at3, at3.totalPCMFrameCount, (drat3_int16*)pSampleData);
+        } else {
+            totalFramesRead = drat3_read_pcm_frames_f32(&at3, at3.totalPCMFrameCount, (float*)pSampleData);
+        }
+    }
+
     if (pChannels) *pChannels = at3.channels;
     if (pSampleRate) *pSampleRate = at3.sampleRate;
     if (pTotalPCMFrameCount) *pTotalPCMFrameCount = totalFramesRead;
-    
+
     drat3_uninit(&at3);
-    
+
     return pSampleData;
 }
 
-drat3_int16* drat3_open_memory_and_read_pcm_frames_s16(const void* pData, size_t dataSize, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
-    drat3 at3;
-    drat3_config config;
-    drat3_int16* pSampleData;
-    drat3_uint64 totalFramesRead;
-    
-    if (pChannels) *pChannels = 0;
-    if (pSampleRate) *pSampleRate = 0;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = 0;
-    
-    memset(&config, 0, sizeof(config));
-    if (pAllocationCallbacks) {
-        config.allocationCallbacks = *pAllocationCallbacks;
-    }
-    
-    if (drat3_init_memory(pData, dataSize, &config, &at3) != DRAT3_SUCCESS) {
+#ifndef DR_AT3_NO_STDIO
+float* drat3_open_file_and_read_pcm_frames_f32(const char* pFilePath, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    if (pFilePath == NULL) {
         return NULL;
     }
-    
-    pSampleData = (drat3_int16*)drat3__malloc((size_t)(at3.totalPCMFrameCount * at3.channels * sizeof(drat3_int16)), pAllocationCallbacks);
-    if (pSampleData == NULL) {
-        drat3_uninit(&at3);
+    return (float*)drat3__open_and_read_pcm_frames(pFilePath, NULL, 0, pChannels, pSampleRate, pTotalPCMFrameCount, DRAT3_FALSE, pAllocationCallbacks);
+}
+
+drat3_int16* drat3_open_file_and_read_pcm_frames_s16(const char* pFilePath, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    if (pFilePath == NULL) {
         return NULL;
     }
-    
-    totalFramesRead = drat3_read_pcm_frames_s16(&at3, at3.totalPCMFrameCount, pSampleData);
-    
-    if (pChannels) *pChannels = at3.channels;
-    if (pSampleRate) *pSampleRate = at3.sampleRate;
-    if (pTotalPCMFrameCount) *pTotalPCMFrameCount = totalFramesRead;
-    
-    drat3_uninit(&at3);
-    
-    return pSampleData;
+    return (drat3_int16*)drat3__open_and_read_pcm_frames(pFilePath, NULL, 0, pChannels, pSampleRate, pTotalPCMFrameCount, DRAT3_TRUE, pAllocationCallbacks);
+}
+#endif
+
+float* drat3_open_memory_and_read_pcm_frames_f32(const void* pData, size_t dataSize, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    return (float*)drat3__open_and_read_pcm_frames(NULL, pData, dataSize, pChannels, pSampleRate, pTotalPCMFrameCount, DRAT3_FALSE, pAllocationCallbacks);
+}
+
+drat3_int16* drat3_open_memory_and_read_pcm_frames_s16(const void* pData, size_t dataSize, drat3_uint32* pChannels, drat3_uint32* pSampleRate, drat3_uint64* pTotalPCMFrameCount, const drat3_allocation_callbacks* pAllocationCallbacks) {
+    return (drat3_int16*)drat3__open_and_read_pcm_frames(NULL, pData, dataSize, pChannels, pSampleRate, pTotalPCMFrameCount, DRAT3_TRUE, pAllocationCallbacks);
 }
 
 void drat3_free(void* p, const drat3_allocation_callbacks* pAllocationCallbacks) {
@@ -58,6 +58,14 @@ extern "C" {
         return 32;
     }
     #define __builtin_clz(x) dr_opus__clz(x)
+    /* Count trailing zeros - MSVC version */
+    static __inline int dr_opus__ctz(unsigned int x) {
+        unsigned long index;
+        if (_BitScanForward(&index, x)) return (int)index;
+        return 32;
+    }
+    #define __builtin_ctz(x) dr_opus__ctz(x)
+    #define __builtin_bswap32(x) _byteswap_ulong(x)
     /* Stack allocation for MSVC (no VLA support) */
     #include <malloc.h>
     #define DR_OPUS_ALLOCA(size) _alloca(size)
@@ -139,7 +147,8 @@ typedef struct {
     /* Ogg state */
     drlibs_uint32 oggSerial;
     drlibs_bool32 oggHeadersRead;
-    drlibs_uint8 oggPageBuffer[65307];
+    drlibs_uint8* pOggPageBuffer;     /* File sources only. Memory sources reference page payloads in place. */
+    const drlibs_uint8* pOggPageData; /* Payload of the current page. */
     drlibs_uint32 oggPageDataSize;
     drlibs_uint32 oggPageDataPos;
     drlibs_uint8 oggSegmentTable[255];
@@ -147,8 +156,9 @@ typedef struct {
     drlibs_uint8 oggCurrentSegment;
     drlibs_int64 oggGranulePosition;
     
-    /* Decode buffer */
-    float decodeBuffer[5760*2];
+    /* Decode buffer. Allocated on first staged decode; reads large enough to
+       take whole packets bypass it entirely and never allocate. */
+    float* pDecodeBuffer;
     drlibs_uint32 decodeBufferLen;
     drlibs_uint32 decodeBufferPos;
     drlibs_uint32 preSkipRemaining;
@@ -222,6 +232,45 @@ static void dr_opus__free(void* p, const dr_opus_allocation_callbacks* pAlloc) {
     free(p);
 }
 
+/*
+SIMD support. Hot DSP kernels below carry guarded SSE2/AVX2/NEON paths with a scalar
+fallback; define DR_OPUS_NO_SIMD to force the scalar code everywhere.
+*/
+#if !defined(DR_OPUS_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+        #define DR_OPUS_SUPPORT_SSE2
+        #include <emmintrin.h>
+    #endif
+    #if defined(__AVX2__)
+        #define DR_OPUS_SUPPORT_AVX2
+        #include <immintrin.h>
+    #endif
+    #if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+        #define DR_OPUS_SUPPORT_NEON
+        #include <arm_neon.h>
+    #endif
+    #if defined(__PCLMUL__) && defined(__SSSE3__)
+        #define DR_OPUS_SUPPORT_PCLMUL
+        #include <wmmintrin.h>
+        #include <tmmintrin.h>
+    #endif
+    #if defined(__LZCNT__)
+        #define DR_OPUS_SUPPORT_LZCNT
+        #include <immintrin.h>
+    #endif
+    /* The icdf scan in ec_dec_icdf reads whole aligned 16-byte blocks, which
+       can touch padding past the end of a table. That never crosses a page
+       boundary but trips AddressSanitizer, so it reverts to scalar under
+       ASan. */
+    #if defined(__SANITIZE_ADDRESS__)
+        #define DR_OPUS_ASAN
+    #elif defined(__has_feature)
+        #if __has_feature(address_sanitizer)
+            #define DR_OPUS_ASAN
+        #endif
+    #endif
+#endif
+
 /*******************************************************************************
  * EMBEDDED LIBOPUS 1.4 DECODER
  ******************************************************************************/
@@ -229,8 +278,6 @@ typedef float celt_sig;
 typedef float celt_norm;
 typedef float celt_ener;
 
-extern const opus_uint32 SMALL_DIV_TABLE[129];
-
 
 
 
@@ -270,6 +317,13 @@ struct ec_ctx{
    int rem;
 
    int error;
+
+   /* Cached reciprocal for the rng/_ft division in ec_decode. _ft is
+      typically reused across consecutive symbols, so the divide is replaced
+      by a widening multiply on a hit. div_ft==0 means no entry. */
+   opus_uint32 div_ft;
+   opus_uint64 div_rec;
+   int div_shift;
 };
 
 static inline opus_uint32 ec_range_bytes(ec_ctx *_this){
@@ -409,6 +463,32 @@ static int ec_read_byte_from_end(ec_dec *_this){
 
 
 static void ec_dec_normalize(ec_dec *_this){
+  /*
+  Fast path: rng needs at most three byte refills (rng>=1 after an update), and each
+  iteration's sym is just the previous/current byte pair shifted right one bit. When the
+  next three input bytes are in bounds we can load them once, derive every sym from a
+  single shift of the combined word and fold them into val in one step, instead of
+  looping with a data-dependent branch. Matches the loop below bit-for-bit.
+  */
+  if(_this->rng<=((((opus_uint32)1U)<<((32)-1))>>(8))&&_this->offs+3<=_this->storage){
+    int n;
+    opus_uint32 chunk;
+    opus_uint32 folded;
+    /* 1..3 refill bytes. Counted off rng-1 because the loop condition is inclusive at powers of two; |1 keeps clz defined for rng==1. */
+    n=(__builtin_clz((_this->rng-1)|1)-1)>>3;
+    chunk=((opus_uint32)_this->rem<<24)|
+          ((opus_uint32)_this->buf[_this->offs+0]<<16)|
+          ((opus_uint32)_this->buf[_this->offs+1]<<8)|
+           (opus_uint32)_this->buf[_this->offs+2];
+    /* Byte i of chunk>>1 (from the top, after rem) is iteration i's sym. */
+    folded=((~(chunk>>1))>>(8*(3-n)))&(((opus_uint32)1<<(8*n))-1);
+    _this->val=((_this->val<<(8*n))+folded)&((((opus_uint32)1U)<<((32)-1))-1);
+    _this->rng<<=(8*n);
+    _this->nbits_total+=(8)*n;
+    _this->rem=_this->buf[_this->offs+n-1];
+    _this->offs+=n;
+    return;
+  }
 
   while(_this->rng<=((((opus_uint32)1U)<<((32)-1))>>(8))){
     int sym;
@@ -441,13 +521,28 @@ void ec_dec_init(ec_dec *_this,unsigned char *_buf,opus_uint32 _storage){
   _this->rem=ec_read_byte(_this);
   _this->val=_this->rng-1-(_this->rem>>((8)-(((32)-2)%(8)+1)));
   _this->error=0;
+  _this->div_ft=0;
 
   ec_dec_normalize(_this);
 }
 
 unsigned ec_decode(ec_dec *_this,unsigned _ft){
   unsigned s;
-  _this->ext=celt_udiv(_this->rng,_ft);
+  /*rng/_ft via a cached Granlund-Montgomery reciprocal: with
+    m=ceil(2^(32+l)/_ft), l=ceil(log2(_ft)), floor(m*n>>(32+l))==n/_ft for all
+    n<=2^31; rng<=2^31 always holds here, which also keeps the 64-bit product
+    m*n (m<2^33) from overflowing. A cache
+    miss costs one divide (same as before) plus the clz; hits cost a multiply.*/
+  if(_ft>0x80000000U)_this->ext=celt_udiv(_this->rng,_ft);
+  else{
+    if(_ft!=_this->div_ft){
+      int l=_ft<=1?0:32-__builtin_clz(_ft-1);
+      _this->div_ft=_ft;
+      _this->div_shift=32+l;
+      _this->div_rec=((((opus_uint64)1)<<(32+l))+_ft-1)/_ft;
+    }
+    _this->ext=(opus_uint32)(((opus_uint64)_this->rng*_this->div_rec)>>_this->div_shift);
+  }
   s=(unsigned)(_this->val/_this->ext);
   return _ft-((s+1)+(((_ft)-(s+1))&-((_ft)<(s+1))));
 }
@@ -492,12 +587,43 @@ int ec_dec_icdf(ec_dec *_this,const unsigned char *_icdf,unsigned _ftb){
   s=_this->rng;
   d=_this->val;
   r=s>>_ftb;
-  ret=-1;
-  do{
-    t=s;
-    s=((r)*(_icdf[++ret]));
+#if defined(DR_OPUS_SUPPORT_SSE2) && !defined(DR_OPUS_ASAN)
+  /*
+  The scalar loop below walks the table with a mispredicted data-dependent branch. But the
+  table is non-increasing and 0-terminated, and d<r*icdf[i] is equivalent to icdf[i]>d/r,
+  so the symbol is simply the count of leading table bytes greater than d/r: one division,
+  then a branchless byte scan. Loads are 16-byte aligned so they cannot fault, and the
+  terminator guarantees a stop bit within the table, so no lane past it is ever consumed.
+  */
+  if(r!=0){
+    opus_uint32 q=d/r;
+    const __m128i bias=_mm_set1_epi8((char)0x80);
+    const __m128i vq=_mm_set1_epi8((char)((q>255?255:q)^0x80));
+    uintptr_t mis=(uintptr_t)_icdf&15;
+    const unsigned char *p=_icdf-mis;
+    unsigned stop;
+    ret=-(int)mis;
+    stop=~(unsigned)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_xor_si128(_mm_load_si128((const __m128i*)p),bias),vq));
+    stop&=(0xFFFFu<<mis)&0xFFFFu;
+    while(stop==0){
+      p+=16;
+      ret+=16;
+      stop=~(unsigned)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_xor_si128(_mm_load_si128((const __m128i*)p),bias),vq))&0xFFFFu;
+    }
+    ret+=__builtin_ctz(stop);
+    s=((r)*(_icdf[ret]));
+    t=ret>0?((r)*(_icdf[ret-1])):_this->rng;
+  }
+  else
+#endif
+  {
+    ret=-1;
+    do{
+      t=s;
+      s=((r)*(_icdf[++ret]));
+    }
+    while(d<s);
   }
-  while(d<s);
   _this->val=d-s;
   _this->rng=t-s;
   ec_dec_normalize(_this);
@@ -539,7 +665,22 @@ opus_uint32 ec_dec_bits(ec_dec *_this,unsigned _bits){
   window=_this->end_window;
   available=_this->nend_bits;
   if((unsigned)available<_bits){
-    do{
+    /*
+    The refill loop reads exactly n=(24-available)/8+1 trailing bytes, each with its own
+    bounds check. When they are all in bounds, grab them with one 4-byte load instead:
+    the stream's last unread byte must land in the low bits, so byte-reverse the load and
+    mask it down to the n bytes the loop would have consumed.
+    */
+    int n=((((int)sizeof(ec_window)*8-8)-available)>>3)+1;
+    if(_this->end_offs+4<=_this->storage){
+      opus_uint32 w;
+      memcpy(&w,_this->buf+_this->storage-_this->end_offs-4,sizeof(w));
+      w=__builtin_bswap32(w);
+      window|=(ec_window)(w&(0xFFFFFFFFu>>(32-8*n)))<<available;
+      _this->end_offs+=(opus_uint32)n;
+      available+=8*n;
+    }
+    else do{
       window|=(ec_window)ec_read_byte_from_end(_this)<<available;
       available+=(8);
     }
@@ -832,6 +973,9 @@ unsigned isqrt32(opus_uint32 _val);
 
 static inline float fast_atan2f(float y, float x) {
    float x2, y2;
+   float a2, b2;
+   float den, r, hp_y;
+   int swap;
    x2 = x*x;
    y2 = y*y;
 
@@ -840,20 +984,89 @@ static inline float fast_atan2f(float y, float x) {
    {
       return 0;
    }
-   if(x2<y2){
-      float den = (y2 + 0.67848403f*x2) * (y2 + 0.08595542f*x2);
-      return -x*y*(y2 + 0.43157974f*x2) / den + (y<0 ? -((float)3.141592653f/2) : ((float)3.141592653f/2));
-   }else{
-      float den = (x2 + 0.67848403f*y2) * (x2 + 0.08595542f*y2);
-      return x*y*(x2 + 0.43157974f*y2) / den + (y<0 ? -((float)3.141592653f/2) : ((float)3.141592653f/2)) - (x*y<0 ? -((float)3.141592653f/2) : ((float)3.141592653f/2));
+   /*
+   Both arms of the original x2<y2 branch evaluate the same rational approximation with the
+   operands exchanged, so canonicalize into (a2,b2) with a2>=b2 and run the polynomial once.
+   The remaining ternaries are pure selects (no divergent work), which compilers lower to
+   conditional moves instead of the unpredictable per-bin branch. Products and the final
+   addition order match the original arms exactly.
+   */
+   swap = x2 < y2;
+   a2 = swap ? y2 : x2;
+   b2 = swap ? x2 : y2;
+   den = (a2 + 0.67848403f*b2) * (a2 + 0.08595542f*b2);
+   r = x*y*(a2 + 0.43157974f*b2) / den;
+   hp_y = (y<0 ? -((float)3.141592653f/2) : ((float)3.141592653f/2));
+   if (swap) {
+      return -r + hp_y;
+   } else {
+      return r + hp_y - (x*y<0 ? -((float)3.141592653f/2) : ((float)3.141592653f/2));
    }
 }
 static inline opus_val32 celt_maxabs16(const opus_val16 *x, int len)
 {
-   int i;
+   int i = 0;
    opus_val16 maxval = 0;
    opus_val16 minval = 0;
-   for (i=0;i<len;i++)
+#if defined(DR_OPUS_SUPPORT_AVX2)
+   if (len >= 16)
+   {
+      __m256 vmax = _mm256_setzero_ps();
+      __m256 vmin = _mm256_setzero_ps();
+      __m128 max4, min4;
+      for (;i+8<=len;i+=8)
+      {
+         __m256 v = _mm256_loadu_ps(x+i);
+         vmax = _mm256_max_ps(vmax, v);
+         vmin = _mm256_min_ps(vmin, v);
+      }
+      max4 = _mm_max_ps(_mm256_castps256_ps128(vmax), _mm256_extractf128_ps(vmax, 1));
+      min4 = _mm_min_ps(_mm256_castps256_ps128(vmin), _mm256_extractf128_ps(vmin, 1));
+      max4 = _mm_max_ps(max4, _mm_movehl_ps(max4, max4));
+      min4 = _mm_min_ps(min4, _mm_movehl_ps(min4, min4));
+      max4 = _mm_max_ss(max4, _mm_shuffle_ps(max4, max4, 1));
+      min4 = _mm_min_ss(min4, _mm_shuffle_ps(min4, min4, 1));
+      maxval = _mm_cvtss_f32(max4);
+      minval = _mm_cvtss_f32(min4);
+   }
+#elif defined(DR_OPUS_SUPPORT_SSE2)
+   if (len >= 8)
+   {
+      __m128 vmax = _mm_setzero_ps();
+      __m128 vmin = _mm_setzero_ps();
+      for (;i+4<=len;i+=4)
+      {
+         __m128 v = _mm_loadu_ps(x+i);
+         vmax = _mm_max_ps(vmax, v);
+         vmin = _mm_min_ps(vmin, v);
+      }
+      vmax = _mm_max_ps(vmax, _mm_movehl_ps(vmax, vmax));
+      vmin = _mm_min_ps(vmin, _mm_movehl_ps(vmin, vmin));
+      vmax = _mm_max_ss(vmax, _mm_shuffle_ps(vmax, vmax, 1));
+      vmin = _mm_min_ss(vmin, _mm_shuffle_ps(vmin, vmin, 1));
+      maxval = _mm_cvtss_f32(vmax);
+      minval = _mm_cvtss_f32(vmin);
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   if (len >= 8)
+   {
+      float32x4_t vmax = vdupq_n_f32(0);
+      float32x4_t vmin = vdupq_n_f32(0);
+      for (;i+4<=len;i+=4)
+      {
+         float32x4_t v = vld1q_f32(x+i);
+         vmax = vmaxq_f32(vmax, v);
+         vmin = vminq_f32(vmin, v);
+      }
+      {
+         float32x2_t max2 = vpmax_f32(vget_low_f32(vmax), vget_high_f32(vmax));
+         float32x2_t min2 = vpmin_f32(vget_low_f32(vmin), vget_high_f32(vmin));
+         maxval = vget_lane_f32(vpmax_f32(max2, max2), 0);
+         minval = vget_lane_f32(vpmin_f32(min2, min2), 0);
+      }
+   }
+#endif
+   for (;i<len;i++)
    {
       maxval = ((maxval) > (x[i]) ? (maxval) : (x[i]));
       minval = ((minval) < (x[i]) ? (minval) : (x[i]));
@@ -939,10 +1152,13 @@ int ec_laplace_decode(ec_dec *dec, unsigned fs, int decay)
          val += di;
          fl += 2*di*(1<<(0));
       }
-      if (fm < fl+fs)
-         val = -val;
-      else
-         fl += fs;
+      /* The sign is equiprobable, so apply it with the same mask idiom the
+         encoder uses for s rather than an unpredictable branch. */
+      {
+         int sgn = -(int)(fm < fl+fs);
+         val = (val+sgn)^sgn;
+         fl += fs&~(unsigned)sgn;
+      }
    }
    ;
    ;
@@ -961,9 +1177,9 @@ int log2_frac(opus_uint32 val, int frac);
 
 void get_required_bits(opus_int16 *bits, int N, int K, int frac);
 
-void encode_pulses(const int *_y, int N, int K, ec_enc *enc);
+void encode_pulses(const int * restrict _y, int N, int K, ec_enc *enc);
 
-opus_val32 decode_pulses(int *_y, int N, int K, ec_dec *dec);
+opus_val32 decode_pulses(int * restrict _y, int N, int K, ec_dec *dec);
 int log2_frac(opus_uint32 val, int frac)
 {
   int l;
@@ -975,6 +1191,23 @@ int log2_frac(opus_uint32 val, int frac)
 
     if(l>16)val=((val-1)>>(l-16))+1;
     else val<<=16-l;
+
+    /*
+    After normalization the digit-extraction loop depends only on the 16-bit mantissa, and
+    every caller in this file uses frac==3, so the common case collapses to a straight-line
+    threshold count. The thresholds were generated from the loop below and the whole 32-bit
+    input range verified to match it exactly.
+    */
+    if(frac==3){
+      static const opus_uint32 log2_frac3_thresh[7]=
+        {0x8B95,0x9837,0xA5FE,0xB504,0xC566,0xD744,0xEAC0};
+      return ((l-1)<<3)+1
+        +(val>log2_frac3_thresh[0])+(val>log2_frac3_thresh[1])
+        +(val>log2_frac3_thresh[2])+(val>log2_frac3_thresh[3])
+        +(val>log2_frac3_thresh[4])+(val>log2_frac3_thresh[5])
+        +(val>log2_frac3_thresh[6]);
+    }
+
     l=(l-1)<<frac;
 
 
@@ -992,225 +1225,302 @@ int log2_frac(opus_uint32 val, int frac)
 
   else return (l-1)<<frac;
 }
-static const opus_uint32 CELT_PVQ_U_DATA[1488]={
-
-
-
-
-  1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-
-
-  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-  0, 0, 0, 0, 0, 0,
-
-
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-
-
-  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-  1, 1, 1, 1, 1, 1,
-
-
-  3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31, 33, 35, 37, 39, 41,
-  43, 45, 47, 49, 51, 53, 55, 57, 59, 61, 63, 65, 67, 69, 71, 73, 75, 77, 79,
-  81, 83, 85, 87, 89, 91, 93, 95, 97, 99, 101, 103, 105, 107, 109, 111, 113,
-  115, 117, 119, 121, 123, 125, 127, 129, 131, 133, 135, 137, 139, 141, 143,
-  145, 147, 149, 151, 153, 155, 157, 159, 161, 163, 165, 167, 169, 171, 173,
-  175, 177, 179, 181, 183, 185, 187, 189, 191, 193, 195, 197, 199, 201, 203,
-  205, 207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233,
-  235, 237, 239, 241, 243, 245, 247, 249, 251, 253, 255, 257, 259, 261, 263,
-  265, 267, 269, 271, 273, 275, 277, 279, 281, 283, 285, 287, 289, 291, 293,
-  295, 297, 299, 301, 303, 305, 307, 309, 311, 313, 315, 317, 319, 321, 323,
-  325, 327, 329, 331, 333, 335, 337, 339, 341, 343, 345, 347, 349, 351,
-
-
-  353, 355, 357, 359, 361, 363, 365, 367, 369, 371, 373, 375, 377, 379, 381,
-  383, 385, 387, 389, 391, 393, 395, 397, 399, 401, 403, 405, 407, 409, 411,
-  413, 415,
-
-
-  13, 25, 41, 61, 85, 113, 145, 181, 221, 265, 313, 365, 421, 481, 545, 613,
-  685, 761, 841, 925, 1013, 1105, 1201, 1301, 1405, 1513, 1625, 1741, 1861,
-  1985, 2113, 2245, 2381, 2521, 2665, 2813, 2965, 3121, 3281, 3445, 3613, 3785,
-  3961, 4141, 4325, 4513, 4705, 4901, 5101, 5305, 5513, 5725, 5941, 6161, 6385,
-  6613, 6845, 7081, 7321, 7565, 7813, 8065, 8321, 8581, 8845, 9113, 9385, 9661,
-  9941, 10225, 10513, 10805, 11101, 11401, 11705, 12013, 12325, 12641, 12961,
-  13285, 13613, 13945, 14281, 14621, 14965, 15313, 15665, 16021, 16381, 16745,
-  17113, 17485, 17861, 18241, 18625, 19013, 19405, 19801, 20201, 20605, 21013,
-  21425, 21841, 22261, 22685, 23113, 23545, 23981, 24421, 24865, 25313, 25765,
-  26221, 26681, 27145, 27613, 28085, 28561, 29041, 29525, 30013, 30505, 31001,
-  31501, 32005, 32513, 33025, 33541, 34061, 34585, 35113, 35645, 36181, 36721,
-  37265, 37813, 38365, 38921, 39481, 40045, 40613, 41185, 41761, 42341, 42925,
-  43513, 44105, 44701, 45301, 45905, 46513, 47125, 47741, 48361, 48985, 49613,
-  50245, 50881, 51521, 52165, 52813, 53465, 54121, 54781, 55445, 56113, 56785,
-  57461, 58141, 58825, 59513, 60205, 60901, 61601,
-
-
-  62305, 63013, 63725, 64441, 65161, 65885, 66613, 67345, 68081, 68821, 69565,
-  70313, 71065, 71821, 72581, 73345, 74113, 74885, 75661, 76441, 77225, 78013,
-  78805, 79601, 80401, 81205, 82013, 82825, 83641, 84461, 85285, 86113,
-
-
-  63, 129, 231, 377, 575, 833, 1159, 1561, 2047, 2625, 3303, 4089, 4991, 6017,
-  7175, 8473, 9919, 11521, 13287, 15225, 17343, 19649, 22151, 24857, 27775,
-  30913, 34279, 37881, 41727, 45825, 50183, 54809, 59711, 64897, 70375, 76153,
-  82239, 88641, 95367, 102425, 109823, 117569, 125671, 134137, 142975, 152193,
-  161799, 171801, 182207, 193025, 204263, 215929, 228031, 240577, 253575,
-  267033, 280959, 295361, 310247, 325625, 341503, 357889, 374791, 392217,
-  410175, 428673, 447719, 467321, 487487, 508225, 529543, 551449, 573951,
-  597057, 620775, 645113, 670079, 695681, 721927, 748825, 776383, 804609,
-  833511, 863097, 893375, 924353, 956039, 988441, 1021567, 1055425, 1090023,
-  1125369, 1161471, 1198337, 1235975, 1274393, 1313599, 1353601, 1394407,
-  1436025, 1478463, 1521729, 1565831, 1610777, 1656575, 1703233, 1750759,
-  1799161, 1848447, 1898625, 1949703, 2001689, 2054591, 2108417, 2163175,
-  2218873, 2275519, 2333121, 2391687, 2451225, 2511743, 2573249, 2635751,
-  2699257, 2763775, 2829313, 2895879, 2963481, 3032127, 3101825, 3172583,
-  3244409, 3317311, 3391297, 3466375, 3542553, 3619839, 3698241, 3777767,
-  3858425, 3940223, 4023169, 4107271, 4192537, 4278975, 4366593, 4455399,
-  4545401, 4636607, 4729025, 4822663, 4917529, 5013631, 5110977, 5209575,
-  5309433, 5410559, 5512961, 5616647, 5721625, 5827903, 5935489, 6044391,
-  6154617, 6266175, 6379073, 6493319, 6608921, 6725887, 6844225, 6963943,
-  7085049, 7207551,
-
-
-  7331457, 7456775, 7583513, 7711679, 7841281, 7972327, 8104825, 8238783,
-  8374209, 8511111, 8649497, 8789375, 8930753, 9073639, 9218041, 9363967,
-  9511425, 9660423, 9810969, 9963071, 10116737, 10271975, 10428793, 10587199,
-  10747201, 10908807, 11072025, 11236863, 11403329, 11571431, 11741177,
-  11912575,
-
-
-  321, 681, 1289, 2241, 3649, 5641, 8361, 11969, 16641, 22569, 29961, 39041,
-  50049, 63241, 78889, 97281, 118721, 143529, 172041, 204609, 241601, 283401,
-  330409, 383041, 441729, 506921, 579081, 658689, 746241, 842249, 947241,
-  1061761, 1186369, 1321641, 1468169, 1626561, 1797441, 1981449, 2179241,
-  2391489, 2618881, 2862121, 3121929, 3399041, 3694209, 4008201, 4341801,
-  4695809, 5071041, 5468329, 5888521, 6332481, 6801089, 7295241, 7815849,
-  8363841, 8940161, 9545769, 10181641, 10848769, 11548161, 12280841, 13047849,
-  13850241, 14689089, 15565481, 16480521, 17435329, 18431041, 19468809,
-  20549801, 21675201, 22846209, 24064041, 25329929, 26645121, 28010881,
-  29428489, 30899241, 32424449, 34005441, 35643561, 37340169, 39096641,
-  40914369, 42794761, 44739241, 46749249, 48826241, 50971689, 53187081,
-  55473921, 57833729, 60268041, 62778409, 65366401, 68033601, 70781609,
-  73612041, 76526529, 79526721, 82614281, 85790889, 89058241, 92418049,
-  95872041, 99421961, 103069569, 106816641, 110664969, 114616361, 118672641,
-  122835649, 127107241, 131489289, 135983681, 140592321, 145317129, 150160041,
-  155123009, 160208001, 165417001, 170752009, 176215041, 181808129, 187533321,
-  193392681, 199388289, 205522241, 211796649, 218213641, 224775361, 231483969,
-  238341641, 245350569, 252512961, 259831041, 267307049, 274943241, 282741889,
-  290705281, 298835721, 307135529, 315607041, 324252609, 333074601, 342075401,
-  351257409, 360623041, 370174729, 379914921, 389846081, 399970689, 410291241,
-  420810249, 431530241, 442453761, 453583369, 464921641, 476471169, 488234561,
-  500214441, 512413449, 524834241, 537479489, 550351881, 563454121, 576788929,
-  590359041, 604167209, 618216201, 632508801,
-
-
-  647047809, 661836041, 676876329, 692171521, 707724481, 723538089, 739615241,
-  755958849, 772571841, 789457161, 806617769, 824056641, 841776769, 859781161,
-  878072841, 896654849, 915530241, 934702089, 954173481, 973947521, 994027329,
-  1014416041, 1035116809, 1056132801, 1077467201, 1099123209, 1121104041,
-  1143412929, 1166053121, 1189027881, 1212340489, 1235994241,
-
-
-  1683, 3653, 7183, 13073, 22363, 36365, 56695, 85305, 124515, 177045, 246047,
-  335137, 448427, 590557, 766727, 982729, 1244979, 1560549, 1937199, 2383409,
-  2908411, 3522221, 4235671, 5060441, 6009091, 7095093, 8332863, 9737793,
-  11326283, 13115773, 15124775, 17372905, 19880915, 22670725, 25765455,
-  29189457, 32968347, 37129037, 41699767, 46710137, 52191139, 58175189,
-  64696159, 71789409, 79491819, 87841821, 96879431, 106646281, 117185651,
-  128542501, 140763503, 153897073, 167993403, 183104493, 199284183, 216588185,
-  235074115, 254801525, 275831935, 298228865, 322057867, 347386557, 374284647,
-  402823977, 433078547, 465124549, 499040399, 534906769, 572806619, 612825229,
-  655050231, 699571641, 746481891, 795875861, 847850911, 902506913, 959946283,
-  1020274013, 1083597703, 1150027593, 1219676595, 1292660325, 1369097135,
-  1449108145, 1532817275, 1620351277, 1711839767, 1807415257, 1907213187,
-  2011371957, 2120032959,
-
-
-  2233340609U, 2351442379U, 2474488829U, 2602633639U, 2736033641U, 2874848851U,
-  3019242501U, 3169381071U, 3325434321U, 3487575323U, 3655980493U, 3830829623U,
-  4012305913U,
-
-
-  8989, 19825, 40081, 75517, 134245, 227305, 369305, 579125, 880685, 1303777,
-  1884961, 2668525, 3707509, 5064793, 6814249, 9041957, 11847485, 15345233,
-  19665841, 24957661, 31388293, 39146185, 48442297, 59511829, 72616013,
-  88043969, 106114625, 127178701, 151620757, 179861305, 212358985, 249612805,
-  292164445, 340600625, 395555537, 457713341, 527810725, 606639529, 695049433,
-  793950709, 904317037, 1027188385, 1163673953, 1314955181, 1482288821,
-  1667010073, 1870535785, 2094367717,
-
-
-  2340095869U, 2609401873U, 2904062449U, 3225952925U, 3577050821U, 3959439497U,
-
-
-  48639, 108545, 224143, 433905, 795455, 1392065, 2340495, 3800305, 5984767,
-  9173505, 13726991, 20103025, 28875327, 40754369, 56610575, 77500017,
-  104692735, 139703809, 184327311, 240673265, 311207743, 398796225, 506750351,
-  638878193, 799538175, 993696769, 1226990095, 1505789553, 1837271615,
-  2229491905U,
-
-
-  2691463695U, 3233240945U, 3866006015U,
-
-
-  265729, 598417, 1256465, 2485825, 4673345, 8405905, 14546705, 24331777,
-  39490049, 62390545, 96220561, 145198913, 214828609, 312193553, 446304145,
-  628496897, 872893441, 1196924561, 1621925137, 2173806145U,
-
-
-  2883810113U,
-
+/*
+U(n,k) storage split by magnitude: within each row the values grow along the
+column, so every entry below 65536 sits in a prefix that can be stored as 16
+bits. The prefix lives in CELT_PVQ_U16_DATA and the remainder in
+CELT_PVQ_U32_DATA; CELT_PVQ_U_SPLIT holds the first column of each row that
+needs 32 bits and the offset tables are pre-biased so the column indexes
+both halves directly. The dense low-k region that icwrs and cwrsi hammer
+loads half as many bytes this way.
+*/
+static const opus_uint16 CELT_PVQ_U16_DATA[862]={
+       1,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     3,     5,     7,
+       9,    11,    13,    15,    17,    19,    21,    23,    25,    27,
+      29,    31,    33,    35,    37,    39,    41,    43,    45,    47,
+      49,    51,    53,    55,    57,    59,    61,    63,    65,    67,
+      69,    71,    73,    75,    77,    79,    81,    83,    85,    87,
+      89,    91,    93,    95,    97,    99,   101,   103,   105,   107,
+     109,   111,   113,   115,   117,   119,   121,   123,   125,   127,
+     129,   131,   133,   135,   137,   139,   141,   143,   145,   147,
+     149,   151,   153,   155,   157,   159,   161,   163,   165,   167,
+     169,   171,   173,   175,   177,   179,   181,   183,   185,   187,
+     189,   191,   193,   195,   197,   199,   201,   203,   205,   207,
+     209,   211,   213,   215,   217,   219,   221,   223,   225,   227,
+     229,   231,   233,   235,   237,   239,   241,   243,   245,   247,
+     249,   251,   253,   255,   257,   259,   261,   263,   265,   267,
+     269,   271,   273,   275,   277,   279,   281,   283,   285,   287,
+     289,   291,   293,   295,   297,   299,   301,   303,   305,   307,
+     309,   311,   313,   315,   317,   319,   321,   323,   325,   327,
+     329,   331,   333,   335,   337,   339,   341,   343,   345,   347,
+     349,   351,   353,   355,   357,   359,   361,   363,   365,   367,
+     369,   371,   373,   375,   377,   379,   381,   383,   385,   387,
+     389,   391,   393,   395,   397,   399,   401,   403,   405,   407,
+     409,   411,   413,   415,    13,    25,    41,    61,    85,   113,
+     145,   181,   221,   265,   313,   365,   421,   481,   545,   613,
+     685,   761,   841,   925,  1013,  1105,  1201,  1301,  1405,  1513,
+    1625,  1741,  1861,  1985,  2113,  2245,  2381,  2521,  2665,  2813,
+    2965,  3121,  3281,  3445,  3613,  3785,  3961,  4141,  4325,  4513,
+    4705,  4901,  5101,  5305,  5513,  5725,  5941,  6161,  6385,  6613,
+    6845,  7081,  7321,  7565,  7813,  8065,  8321,  8581,  8845,  9113,
+    9385,  9661,  9941, 10225, 10513, 10805, 11101, 11401, 11705, 12013,
+   12325, 12641, 12961, 13285, 13613, 13945, 14281, 14621, 14965, 15313,
+   15665, 16021, 16381, 16745, 17113, 17485, 17861, 18241, 18625, 19013,
+   19405, 19801, 20201, 20605, 21013, 21425, 21841, 22261, 22685, 23113,
+   23545, 23981, 24421, 24865, 25313, 25765, 26221, 26681, 27145, 27613,
+   28085, 28561, 29041, 29525, 30013, 30505, 31001, 31501, 32005, 32513,
+   33025, 33541, 34061, 34585, 35113, 35645, 36181, 36721, 37265, 37813,
+   38365, 38921, 39481, 40045, 40613, 41185, 41761, 42341, 42925, 43513,
+   44105, 44701, 45301, 45905, 46513, 47125, 47741, 48361, 48985, 49613,
+   50245, 50881, 51521, 52165, 52813, 53465, 54121, 54781, 55445, 56113,
+   56785, 57461, 58141, 58825, 59513, 60205, 60901, 61601, 62305, 63013,
+   63725, 64441, 65161,    63,   129,   231,   377,   575,   833,  1159,
+    1561,  2047,  2625,  3303,  4089,  4991,  6017,  7175,  8473,  9919,
+   11521, 13287, 15225, 17343, 19649, 22151, 24857, 27775, 30913, 34279,
+   37881, 41727, 45825, 50183, 54809, 59711, 64897,   321,   681,  1289,
+    2241,  3649,  5641,  8361, 11969, 16641, 22569, 29961, 39041, 50049,
+   63241,  1683,  3653,  7183, 13073, 22363, 36365, 56695,  8989, 19825,
+   40081, 48639
+};
 
-  1462563, 3317445, 7059735, 14218905, 27298155, 50250765, 89129247, 152951073,
-  254831667, 413442773, 654862247, 1014889769, 1541911931, 2300409629U,
-  3375210671U,
+static const opus_uint32 CELT_PVQ_U32_DATA[626]={
+       65885,     66613,     67345,     68081,     68821,     69565,
+       70313,     71065,     71821,     72581,     73345,     74113,
+       74885,     75661,     76441,     77225,     78013,     78805,
+       79601,     80401,     81205,     82013,     82825,     83641,
+       84461,     85285,     86113,     70375,     76153,     82239,
+       88641,     95367,    102425,    109823,    117569,    125671,
+      134137,    142975,    152193,    161799,    171801,    182207,
+      193025,    204263,    215929,    228031,    240577,    253575,
+      267033,    280959,    295361,    310247,    325625,    341503,
+      357889,    374791,    392217,    410175,    428673,    447719,
+      467321,    487487,    508225,    529543,    551449,    573951,
+      597057,    620775,    645113,    670079,    695681,    721927,
+      748825,    776383,    804609,    833511,    863097,    893375,
+      924353,    956039,    988441,   1021567,   1055425,   1090023,
+     1125369,   1161471,   1198337,   1235975,   1274393,   1313599,
+     1353601,   1394407,   1436025,   1478463,   1521729,   1565831,
+     1610777,   1656575,   1703233,   1750759,   1799161,   1848447,
+     1898625,   1949703,   2001689,   2054591,   2108417,   2163175,
+     2218873,   2275519,   2333121,   2391687,   2451225,   2511743,
+     2573249,   2635751,   2699257,   2763775,   2829313,   2895879,
+     2963481,   3032127,   3101825,   3172583,   3244409,   3317311,
+     3391297,   3466375,   3542553,   3619839,   3698241,   3777767,
+     3858425,   3940223,   4023169,   4107271,   4192537,   4278975,
+     4366593,   4455399,   4545401,   4636607,   4729025,   4822663,
+     4917529,   5013631,   5110977,   5209575,   5309433,   5410559,
+     5512961,   5616647,   5721625,   5827903,   5935489,   6044391,
+     6154617,   6266175,   6379073,   6493319,   6608921,   6725887,
+     6844225,   6963943,   7085049,   7207551,   7331457,   7456775,
+     7583513,   7711679,   7841281,   7972327,   8104825,   8238783,
+     8374209,   8511111,   8649497,   8789375,   8930753,   9073639,
+     9218041,   9363967,   9511425,   9660423,   9810969,   9963071,
+    10116737,  10271975,  10428793,  10587199,  10747201,  10908807,
+    11072025,  11236863,  11403329,  11571431,  11741177,  11912575,
+       78889,     97281,    118721,    143529,    172041,    204609,
+      241601,    283401,    330409,    383041,    441729,    506921,
+      579081,    658689,    746241,    842249,    947241,   1061761,
+     1186369,   1321641,   1468169,   1626561,   1797441,   1981449,
+     2179241,   2391489,   2618881,   2862121,   3121929,   3399041,
+     3694209,   4008201,   4341801,   4695809,   5071041,   5468329,
+     5888521,   6332481,   6801089,   7295241,   7815849,   8363841,
+     8940161,   9545769,  10181641,  10848769,  11548161,  12280841,
+    13047849,  13850241,  14689089,  15565481,  16480521,  17435329,
+    18431041,  19468809,  20549801,  21675201,  22846209,  24064041,
+    25329929,  26645121,  28010881,  29428489,  30899241,  32424449,
+    34005441,  35643561,  37340169,  39096641,  40914369,  42794761,
+    44739241,  46749249,  48826241,  50971689,  53187081,  55473921,
+    57833729,  60268041,  62778409,  65366401,  68033601,  70781609,
+    73612041,  76526529,  79526721,  82614281,  85790889,  89058241,
+    92418049,  95872041,  99421961, 103069569, 106816641, 110664969,
+   114616361, 118672641, 122835649, 127107241, 131489289, 135983681,
+   140592321, 145317129, 150160041, 155123009, 160208001, 165417001,
+   170752009, 176215041, 181808129, 187533321, 193392681, 199388289,
+   205522241, 211796649, 218213641, 224775361, 231483969, 238341641,
+   245350569, 252512961, 259831041, 267307049, 274943241, 282741889,
+   290705281, 298835721, 307135529, 315607041, 324252609, 333074601,
+   342075401, 351257409, 360623041, 370174729, 379914921, 389846081,
+   399970689, 410291241, 420810249, 431530241, 442453761, 453583369,
+   464921641, 476471169, 488234561, 500214441, 512413449, 524834241,
+   537479489, 550351881, 563454121, 576788929, 590359041, 604167209,
+   618216201, 632508801, 647047809, 661836041, 676876329, 692171521,
+   707724481, 723538089, 739615241, 755958849, 772571841, 789457161,
+   806617769, 824056641, 841776769, 859781161, 878072841, 896654849,
+   915530241, 934702089, 954173481, 973947521, 994027329,1014416041,
+  1035116809,1056132801,1077467201,1099123209,1121104041,1143412929,
+  1166053121,1189027881,1212340489,1235994241,     85305,    124515,
+      177045,    246047,    335137,    448427,    590557,    766727,
+      982729,   1244979,   1560549,   1937199,   2383409,   2908411,
+     3522221,   4235671,   5060441,   6009091,   7095093,   8332863,
+     9737793,  11326283,  13115773,  15124775,  17372905,  19880915,
+    22670725,  25765455,  29189457,  32968347,  37129037,  41699767,
+    46710137,  52191139,  58175189,  64696159,  71789409,  79491819,
+    87841821,  96879431, 106646281, 117185651, 128542501, 140763503,
+   153897073, 167993403, 183104493, 199284183, 216588185, 235074115,
+   254801525, 275831935, 298228865, 322057867, 347386557, 374284647,
+   402823977, 433078547, 465124549, 499040399, 534906769, 572806619,
+   612825229, 655050231, 699571641, 746481891, 795875861, 847850911,
+   902506913, 959946283,1020274013,1083597703,1150027593,1219676595,
+  1292660325,1369097135,1449108145,1532817275,1620351277,1711839767,
+  1807415257,1907213187,2011371957,2120032959,2233340609,2351442379,
+  2474488829,2602633639,2736033641,2874848851,3019242501,3169381071,
+  3325434321,3487575323,3655980493,3830829623,4012305913,     75517,
+      134245,    227305,    369305,    579125,    880685,   1303777,
+     1884961,   2668525,   3707509,   5064793,   6814249,   9041957,
+    11847485,  15345233,  19665841,  24957661,  31388293,  39146185,
+    48442297,  59511829,  72616013,  88043969, 106114625, 127178701,
+   151620757, 179861305, 212358985, 249612805, 292164445, 340600625,
+   395555537, 457713341, 527810725, 606639529, 695049433, 793950709,
+   904317037,1027188385,1163673953,1314955181,1482288821,1667010073,
+  1870535785,2094367717,2340095869,2609401873,2904062449,3225952925,
+  3577050821,3959439497,    108545,    224143,    433905,    795455,
+     1392065,   2340495,   3800305,   5984767,   9173505,  13726991,
+    20103025,  28875327,  40754369,  56610575,  77500017, 104692735,
+   139703809, 184327311, 240673265, 311207743, 398796225, 506750351,
+   638878193, 799538175, 993696769,1226990095,1505789553,1837271615,
+  2229491905,2691463695,3233240945,3866006015,    265729,    598417,
+     1256465,   2485825,   4673345,   8405905,  14546705,  24331777,
+    39490049,  62390545,  96220561, 145198913, 214828609, 312193553,
+   446304145, 628496897, 872893441,1196924561,1621925137,2173806145,
+  2883810113,   1462563,   3317445,   7059735,  14218905,  27298155,
+    50250765,  89129247, 152951073, 254831667, 413442773, 654862247,
+  1014889769,1541911931,2300409629,3375210671,   8097453,  18474633,
+    39753273,  81270333, 158819253, 298199265, 540279585, 948062325,
+  1616336765,2684641785,  45046719, 103274625, 224298231, 464387817,
+   921406335,1759885185,3248227095, 251595969, 579168825,1267854873,
+  2653649025,1409933619
+};
 
-  8097453, 18474633, 39753273, 81270333, 158819253, 298199265, 540279585,
-  948062325, 1616336765,
+static const opus_int16 CELT_PVQ_U_SPLIT[15]={
+  209,209,209,182,38,19,13,10,9,9,10,11,12,13,14
+};
 
+static const opus_int16 CELT_PVQ_U16_OFFSET[15]={
+  0,208,415,621,799,832,845,851,853,853,852,851,850,849,848
+};
 
-  2684641785U,
+static const opus_int16 CELT_PVQ_U32_OFFSET[15]={
+  -209,-209,-209,-182,-11,179,375,475,527,559,579,593,602,608,611
+};
 
+__attribute__((const))
+static inline opus_uint32 pvq_u_entry(int _row,int _col){
+  return _col<CELT_PVQ_U_SPLIT[_row] ?
+   (opus_uint32)CELT_PVQ_U16_DATA[CELT_PVQ_U16_OFFSET[_row]+_col] :
+   CELT_PVQ_U32_DATA[CELT_PVQ_U32_OFFSET[_row]+_col];
+}
 
-  45046719, 103274625, 224298231, 464387817, 921406335, 1759885185,
-  3248227095U,
 
-  251595969, 579168825, 1267854873, 2653649025U,
+/*
+U(n,k) lookup. The row index is min(n,k) and the column max(n,k); sorting the
+operands from the sign of n-k keeps the address computation branch-free, which
+matters in icwrs where n~k makes the compares unpredictable.
+*/
+__attribute__((const))
+static inline opus_uint32 pvq_u(int _n,int _k){
+  int d=_n-_k;
+  int s=d>>31;
+  return pvq_u_entry(_k+(d&s),_n-(d&s));
+}
 
-  1409933619
-};
+/*V(n,k)=U(n,k)+U(n,k+1): size of the codebook including pulse signs.*/
+__attribute__((const))
+static inline opus_uint32 pvq_v(int _n,int _k){
+  return pvq_u(_n,_k)+pvq_u(_n,_k+1);
+}
 
+#if defined(DR_OPUS_PVQ_TABLE_CHECK)
+/*
+Opt-in consistency check for the split U(n,k) storage: walks the recurrence
+U(n,k)=U(n-1,k)+U(n,k-1)+U(n-1,k-1) over every stored entry and returns 0
+when the tables are intact. C offers no compile-time form of this (array
+elements are not integer constant expressions) and this tree compiles
+upstream asserts out, so the check is left for table maintenance builds.
+*/
+static int pvq_u_table_check(void){
+  static const opus_int16 maxcol[15]={
+    208,208,208,208,208,208,109,60,40,29,24,20,18,16,14
+  };
+  int n;
+  int k;
+  for(n=1;n<15;n++){
+    for(k=n;k<=maxcol[n];k++){
+      if(pvq_u(n,k)!=pvq_u(n-1,k)+pvq_u(n,k-1)+pvq_u(n-1,k-1))return 1;
+    }
+  }
+  return 0;
+}
+#endif
 
-static const opus_uint32 *const CELT_PVQ_U_ROW[15]={
-  CELT_PVQ_U_DATA+ 0,CELT_PVQ_U_DATA+ 208,CELT_PVQ_U_DATA+ 415,
-  CELT_PVQ_U_DATA+ 621,CELT_PVQ_U_DATA+ 826,CELT_PVQ_U_DATA+1030,
-  CELT_PVQ_U_DATA+1233,CELT_PVQ_U_DATA+1336,CELT_PVQ_U_DATA+1389,
-  CELT_PVQ_U_DATA+1421,CELT_PVQ_U_DATA+1441,CELT_PVQ_U_DATA+1455,
-  CELT_PVQ_U_DATA+1464,CELT_PVQ_U_DATA+1470,CELT_PVQ_U_DATA+1473
-};
 void get_required_bits(opus_int16 *_bits,int _n,int _maxk,int _frac){
+  opus_uint32 sum[128+1];
   int k;
 
   ;
+  /*
+  Pass 1: materialize V(n,k)=U(n,k)+U(n,k+1) for every k. Once k reaches n the
+  two lookups land in adjacent entries of row n, so each step reuses the value
+  loaded by the previous one and issues a single new load.
+  */
+  for(k=1;k<_n&&k<=_maxk;k++)sum[k]=pvq_v(_n,k);
+  if(k<=_maxk){
+    opus_uint32 u;
+    u=pvq_u_entry(_n,k);
+    for(;k<=_maxk;k++){
+      opus_uint32 u1;
+      u1=pvq_u_entry(_n,k+1);
+      sum[k]=u+u1;
+      u=u1;
+    }
+  }
+  /*Pass 2: convert the sums to log2 bit counts.*/
   _bits[0]=0;
-  for(k=1;k<=_maxk;k++)_bits[k]=log2_frac(((CELT_PVQ_U_ROW[((_n) < (k) ? (_n) : (k))][((_n) > (k) ? (_n) : (k))])+(CELT_PVQ_U_ROW[((_n) < ((k)+1) ? (_n) : ((k)+1))][((_n) > ((k)+1) ? (_n) : ((k)+1))])),_frac);
+  for(k=1;k<=_maxk;k++)_bits[k]=log2_frac(sum[k],_frac);
 }
 
 
-static opus_uint32 icwrs(int _n,const int *_y){
+static opus_uint32 icwrs(int _n,const int * restrict _y,opus_uint32 *_v){
   opus_uint32 i;
   int j;
   int k;
@@ -1220,121 +1530,187 @@ static opus_uint32 icwrs(int _n,const int *_y){
   k=abs(_y[j]);
   do{
     j--;
-    i+=(CELT_PVQ_U_ROW[((_n-j) < (k) ? (_n-j) : (k))][((_n-j) > (k) ? (_n-j) : (k))]);
+    i+=pvq_u(_n-j,k);
     k+=abs(_y[j]);
-    if(_y[j]<0)i+=(CELT_PVQ_U_ROW[((_n-j) < (k+1) ? (_n-j) : (k+1))][((_n-j) > (k+1) ? (_n-j) : (k+1))]);
+    if(_y[j]<0)i+=pvq_u(_n-j,k+1);
   }
   while(j>0);
+  /*
+  The loop ends with k equal to the total pulse count, so the codebook size
+  V(n,k)=U(n,k)+U(n,k+1) falls out here from rows that are already hot,
+  sparing encode_pulses a second pair of table walks.
+  */
+  *_v=pvq_u(_n,k)+pvq_u(_n,k+1);
   return i;
 }
 
-void encode_pulses(const int *_y,int _n,int _k,ec_enc *_enc){
+void encode_pulses(const int * restrict _y,int _n,int _k,ec_enc *_enc){
+  opus_uint32 i;
+  opus_uint32 v;
+  (void)_k;
   ;
-  ec_enc_uint(_enc,icwrs(_n,_y),((CELT_PVQ_U_ROW[((_n) < (_k) ? (_n) : (_k))][((_n) > (_k) ? (_n) : (_k))])+(CELT_PVQ_U_ROW[((_n) < ((_k)+1) ? (_n) : ((_k)+1))][((_n) > ((_k)+1) ? (_n) : ((_k)+1))])));
+  i=icwrs(_n,_y,&v);
+  ec_enc_uint(_enc,i,v);
 }
 
-static opus_val32 cwrsi(int _n,int _k,opus_uint32 _i,int *_y){
+/*
+Return the largest k<_kmax with U(k,n)=pvq_u_entry(k,_n)<=_i, leaving the
+table value in *_p. The column is strictly increasing in k and U(0,n)==0, so
+the linear descent cwrsi used here can be a binary search instead; the row
+index never exceeds 14, so four masked midpoint steps always converge and
+none of them can mispredict the way the data-dependent descent branch does
+when a position carries several pulses.
+*/
+static inline int cwrsi_find_k(int _n,int _kmax,opus_uint32 _i,opus_uint32 *_p){
+  int lo=0;
+  int hi=_kmax-1;
+  int it;
+  for(it=0;it<4;it++){
+    int mid=(lo+hi+1)>>1;
+    int gt=-(int)(pvq_u_entry(mid,_n)>_i);
+    lo=(lo&gt)|(mid&~gt);
+    hi=((mid-1)&gt)|(hi&~gt);
+  }
+  *_p=pvq_u_entry(lo,_n);
+  return lo;
+}
+
+/*
+Subtract _p from *_i when *_i>=_p, returning -1 (all ones) when the
+subtraction happened and 0 otherwise. Deriving the condition from the borrow
+of the subtraction itself lets the compiler emit sub+cmov in place of the
+separate compare, mask materialization and masked subtract of the open-coded
+s=-(_i>=p); _i-=p&s; idiom.
+*/
+static inline int cwrsi_cond_sub(opus_uint32 *_i,opus_uint32 _p){
+#if defined(__GNUC__) || defined(__clang__)
+  opus_uint32 d;
+  int s;
+  s=-(int)!__builtin_sub_overflow(*_i,_p,&d);
+  *_i=s?d:*_i;
+  return s;
+#else
+  int s;
+  s=-(*_i>=_p);
+  *_i-=_p&s;
+  return s;
+#endif
+}
+
+static opus_val32 cwrsi(int _n,int _k,opus_uint32 _i,int * restrict _y){
   opus_uint32 p;
   int s;
   int k0;
   opus_int16 val;
-  opus_val32 yy=0;
+  int * restrict y0=_y;
+  int n0=_n;
   ;
   ;
   while(_n>2){
     opus_uint32 q;
 
     if(_k>=_n){
-      const opus_uint32 *row;
-      row=CELT_PVQ_U_ROW[_n];
-
-      p=row[_k+1];
-      s=-(_i>=p);
-      _i-=p&s;
+      p=pvq_u_entry(_n,_k+1);
+      s=cwrsi_cond_sub(&_i,p);
 
       k0=_k;
-      q=row[_n];
+      q=pvq_u_entry(_n,_n);
       if(q>_i){
         ;
-        _k=_n;
-        do p=CELT_PVQ_U_ROW[--_k][_n];
-        while(p>_i);
+        _k=cwrsi_find_k(_n,_n,_i,&p);
       }
-      else for(p=row[_k];p>_i;p=row[_k])_k--;
+      else for(p=pvq_u_entry(_n,_k);p>_i;p=pvq_u_entry(_n,_k))_k--;
       _i-=p;
       val=(k0-_k+s)^s;
       *_y++=val;
-      yy=((yy)+(opus_val32)(val)*(opus_val32)(val));
     }
 
     else{
 
-      p=CELT_PVQ_U_ROW[_k][_n];
-      q=CELT_PVQ_U_ROW[_k+1][_n];
+      p=pvq_u_entry(_k,_n);
+      q=pvq_u_entry(_k+1,_n);
       if(p<=_i&&_i<q){
         _i-=p;
         *_y++=0;
       }
       else{
 
-        s=-(_i>=q);
-        _i-=q&s;
+        s=cwrsi_cond_sub(&_i,q);
 
         k0=_k;
-        do p=CELT_PVQ_U_ROW[--_k][_n];
-        while(p>_i);
+        _k=cwrsi_find_k(_n,_k,_i,&p);
         _i-=p;
         val=(k0-_k+s)^s;
         *_y++=val;
-        yy=((yy)+(opus_val32)(val)*(opus_val32)(val));
       }
     }
     _n--;
   }
 
   p=2*_k+1;
-  s=-(_i>=p);
-  _i-=p&s;
+  s=cwrsi_cond_sub(&_i,p);
   k0=_k;
   _k=(_i+1)>>1;
   if(_k)_i-=2*_k-1;
   val=(k0-_k+s)^s;
   *_y++=val;
-  yy=((yy)+(opus_val32)(val)*(opus_val32)(val));
 
   s=-(int)_i;
   val=(_k+s)^s;
   *_y=val;
-  yy=((yy)+(opus_val32)(val)*(opus_val32)(val));
-  return yy;
+  /*
+  Sum the energy in one pass over the finished vector instead of a serial
+  float add per decoded coefficient. The values are integers with at most
+  128 total pulses, so the sum of squares is at most 2^14 and the integer
+  accumulation converts to float exactly.
+  */
+  {
+    opus_uint32 yy=0;
+    int j=0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+    {
+      __m128i acc=_mm_setzero_si128();
+      for(;j+8<=n0;j+=8){
+        __m128i a=_mm_loadu_si128((const __m128i*)(y0+j));
+        __m128i b=_mm_loadu_si128((const __m128i*)(y0+j+4));
+        __m128i v=_mm_packs_epi32(a,b);
+        acc=_mm_add_epi32(acc,_mm_madd_epi16(v,v));
+      }
+      acc=_mm_add_epi32(acc,_mm_shuffle_epi32(acc,_MM_SHUFFLE(1,0,3,2)));
+      acc=_mm_add_epi32(acc,_mm_shuffle_epi32(acc,_MM_SHUFFLE(2,3,0,1)));
+      yy=(opus_uint32)_mm_cvtsi128_si32(acc);
+    }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+    {
+      int32x4_t acc=vdupq_n_s32(0);
+      for(;j+4<=n0;j+=4){
+        int32x4_t v=vld1q_s32(y0+j);
+        acc=vmlaq_s32(acc,v,v);
+      }
+      yy=(opus_uint32)(vgetq_lane_s32(acc,0)+vgetq_lane_s32(acc,1)
+                      +vgetq_lane_s32(acc,2)+vgetq_lane_s32(acc,3));
+    }
+#endif
+    for(;j<n0;j++)yy+=(opus_uint32)(y0[j]*y0[j]);
+    return (opus_val32)yy;
+  }
 }
 
-opus_val32 decode_pulses(int *_y,int _n,int _k,ec_dec *_dec){
-  return cwrsi(_n,_k,ec_dec_uint(_dec,((CELT_PVQ_U_ROW[((_n) < (_k) ? (_n) : (_k))][((_n) > (_k) ? (_n) : (_k))])+(CELT_PVQ_U_ROW[((_n) < ((_k)+1) ? (_n) : ((_k)+1))][((_n) > ((_k)+1) ? (_n) : ((_k)+1))]))),_y);
+opus_val32 decode_pulses(int * restrict _y,int _n,int _k,ec_dec *_dec){
+  return cwrsi(_n,_k,ec_dec_uint(_dec,pvq_v(_n,_k)),_y);
 }
 unsigned isqrt32(opus_uint32 _val){
-  unsigned b;
   unsigned g;
-  int bshift;
-
-
-
-
-  g=0;
-  bshift=((((int)sizeof(unsigned)*8
-         )-(__builtin_clz(_val)))-1)>>1;
-  b=1U<<bshift;
-  do{
-    opus_uint32 t;
-    t=(((opus_uint32)g<<1)+b)<<bshift;
-    if(t<=_val){
-      g+=b;
-      _val-=t;
-    }
-    b>>=1;
-    bshift--;
-  }
-  while(bshift>=0);
+  /*
+  The hardware square root gives the answer directly: a double carries the
+  full 32-bit input exactly, so sqrt() lands within one of floor(sqrt(v)) and
+  a two-sided fix-up (in 64 bits, since (g+1)^2 can reach 2^32) makes it
+  exact. This replaces a 16-iteration dependent shift-add loop with one
+  pipelined sqrt instruction plus two compares.
+  */
+  g=(unsigned)sqrt((double)_val);
+  if((opus_uint64)g*g>_val)g--;
+  else if((opus_uint64)(g+1)*(g+1)<=_val)g++;
   return g;
 }
 typedef struct OpusCustomEncoder OpusCustomEncoder;
@@ -1463,38 +1839,89 @@ static const unsigned char spread_icdf[4] = {25, 23, 2, 0};
 static const unsigned char tapset_icdf[3]={2,1,0};
 
 
-static const unsigned char toOpusTable[20] = {
-      0xE0, 0xE8, 0xF0, 0xF8,
-      0xC0, 0xC8, 0xD0, 0xD8,
-      0xA0, 0xA8, 0xB0, 0xB8,
-      0x00, 0x00, 0x00, 0x00,
-      0x80, 0x88, 0x90, 0x98,
+/*
+TOC byte translation, flattened to one table lookup per direction: the tables
+below fold the old range check, the >>3 row lookup and the OR with the low
+three bits into a single load, with -1 stored directly for invalid bytes.
+*/
+static const opus_int16 toOpusLUT[256] = {
+   0xE0,0xE1,0xE2,0xE3,0xE4,0xE5,0xE6,0xE7,
+   0xE8,0xE9,0xEA,0xEB,0xEC,0xED,0xEE,0xEF,
+   0xF0,0xF1,0xF2,0xF3,0xF4,0xF5,0xF6,0xF7,
+   0xF8,0xF9,0xFA,0xFB,0xFC,0xFD,0xFE,0xFF,
+   0xC0,0xC1,0xC2,0xC3,0xC4,0xC5,0xC6,0xC7,
+   0xC8,0xC9,0xCA,0xCB,0xCC,0xCD,0xCE,0xCF,
+   0xD0,0xD1,0xD2,0xD3,0xD4,0xD5,0xD6,0xD7,
+   0xD8,0xD9,0xDA,0xDB,0xDC,0xDD,0xDE,0xDF,
+   0xA0,0xA1,0xA2,0xA3,0xA4,0xA5,0xA6,0xA7,
+   0xA8,0xA9,0xAA,0xAB,0xAC,0xAD,0xAE,0xAF,
+   0xB0,0xB1,0xB2,0xB3,0xB4,0xB5,0xB6,0xB7,
+   0xB8,0xB9,0xBA,0xBB,0xBC,0xBD,0xBE,0xBF,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+   0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,
+   0x88,0x89,0x8A,0x8B,0x8C,0x8D,0x8E,0x8F,
+   0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,
+   0x98,0x99,0x9A,0x9B,0x9C,0x9D,0x9E,0x9F,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1
 };
 
-static const unsigned char fromOpusTable[16] = {
-      0x80, 0x88, 0x90, 0x98,
-      0x40, 0x48, 0x50, 0x58,
-      0x20, 0x28, 0x30, 0x38,
-      0x00, 0x08, 0x10, 0x18
+static const opus_int16 fromOpusLUT[256] = {
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+     -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
+   0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,
+   0x88,0x89,0x8A,0x8B,0x8C,0x8D,0x8E,0x8F,
+   0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,
+   0x98,0x99,0x9A,0x9B,0x9C,0x9D,0x9E,0x9F,
+   0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,
+   0x48,0x49,0x4A,0x4B,0x4C,0x4D,0x4E,0x4F,
+   0x50,0x51,0x52,0x53,0x54,0x55,0x56,0x57,
+   0x58,0x59,0x5A,0x5B,0x5C,0x5D,0x5E,0x5F,
+   0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,
+   0x28,0x29,0x2A,0x2B,0x2C,0x2D,0x2E,0x2F,
+   0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,
+   0x38,0x39,0x3A,0x3B,0x3C,0x3D,0x3E,0x3F,
+   0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,
+   0x08,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,
+   0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,
+   0x18,0x19,0x1A,0x1B,0x1C,0x1D,0x1E,0x1F
 };
 
 static inline int toOpus(unsigned char c)
 {
-   int ret=0;
-   if (c<0xA0)
-      ret = toOpusTable[c>>3];
-   if (ret == 0)
-      return -1;
-   else
-      return ret|(c&0x7);
+   return toOpusLUT[c];
 }
 
 static inline int fromOpus(unsigned char c)
 {
-   if (c<0x80)
-      return -1;
-   else
-      return fromOpusTable[(c>>3)-16] | (c&0x7);
+   return fromOpusLUT[c];
 }
 
 
@@ -1511,9 +1938,43 @@ void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
       opus_val16 g0, opus_val16 g1, int tapset0, int tapset1,
       const opus_val16 *window, int overlap, int arch);
 void init_caps(const OpusCustomMode *m,int *cap,int LM,int C);
+#if !defined(DR_OPUS_NO_SIMD) && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#include <cpuid.h>
+#endif
+
+/* Runtime CPU detection, mirroring celt/x86/x86cpu.c levels:
+   0=C, 1=SSE, 2=SSE2, 3=SSE4.1, 4=AVX2. The arch value is threaded through
+   every DSP call below, so arch-specialized kernels can dispatch on it. Note
+   the SIMD bodies in this file are selected at compile time instead: being a
+   single-header library, they are compiled with the including project's own
+   target flags, so a guarded path can never be an illegal instruction. */
 static inline int opus_select_arch(void)
 {
+#if !defined(DR_OPUS_NO_SIMD) && defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  static int arch = -1;
+  if (arch < 0) {
+    unsigned eax, ebx, ecx, edx;
+    int a = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      if (edx & (1u << 25)) a = 1;
+      if (edx & (1u << 26)) a = 2;
+      if (ecx & (1u << 19)) a = 3;
+      /* AVX2 additionally needs OSXSAVE, OS-enabled YMM state and the leaf-7 bit. */
+      if (a == 3 && (ecx & (1u << 27)) && (ecx & (1u << 28))) {
+        unsigned xlo, xhi;
+        __asm__("xgetbv" : "=a"(xlo), "=d"(xhi) : "c"(0));
+        if ((xlo & 0x6) == 0x6 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 5)))
+          a = 4;
+      }
+    }
+    arch = a;
+  }
+  return arch;
+#elif !defined(DR_OPUS_NO_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+  return 1; /* NEON is architectural on aarch64. */
+#else
   return 0;
+#endif
 }
 typedef struct {
     float r;
@@ -1531,11 +1992,6 @@ typedef struct {
 
 
 
-typedef struct arch_fft_state{
-   int is_supported;
-   void *priv;
-} arch_fft_state;
-
 typedef struct kiss_fft_state{
     int nfft;
     opus_val16 scale;
@@ -1546,7 +2002,8 @@ typedef struct kiss_fft_state{
     opus_int16 factors[2*8];
     const opus_int16 *bitrev;
     const kiss_twiddle_cpx *twiddles;
-    arch_fft_state *arch_fft;
+    const float *twiddles_cos;
+    const float *twiddles_sin;
 } kiss_fft_state;
 kiss_fft_state *opus_fft_alloc_twiddles(int nfft,void * mem,size_t * lenmem, const kiss_fft_state *base, int arch);
 
@@ -1607,25 +2064,28 @@ typedef struct {
 
 
 struct OpusCustomMode {
+   /*
+   Frame-hot members first so the scalars and table pointers read on every
+   frame (band layout, logN and the pulse cache behind bits2pulses and
+   pulses2bits) share the leading cache line; members touched only at setup
+   or once per MDCT, such as the window and FFT state, sit at the end.
+   */
    opus_int32 Fs;
-   int overlap;
-
    int nbEBands;
    int effEBands;
-   opus_val16 preemph[4];
-   const opus_int16 *eBands;
-
-   int maxLM;
-   int nbShortMdcts;
    int shortMdctSize;
+   int nbShortMdcts;
+   int maxLM;
+   int overlap;
+   const opus_int16 *eBands;
+   const opus_int16 *logN;
+   PulseCache cache;
 
+   opus_val16 preemph[4];
    int nbAllocVectors;
    const unsigned char *allocVectors;
-   const opus_int16 *logN;
-
    const opus_val16 *window;
    mdct_lookup mdct;
-   PulseCache cache;
 };
 void compute_pulse_cache(OpusCustomMode *m, int LM);
 
@@ -1634,41 +2094,52 @@ static inline int get_pulses(int i)
    return i<8 ? i : (8 + (i&7)) << ((i>>3)-1);
 }
 
-static inline int bits2pulses(const OpusCustomMode *m, int band, int LM, int bits)
+/*
+Slice-level forms of bits2pulses/pulses2bits. The per-band cache slice costs
+a dependent index load to locate, so callers that query the same band more
+than once (the allocation trim loop in quant_partition) resolve the slice
+once and use these directly.
+*/
+static inline int bits2pulses_cache(const unsigned char *cache, int bits)
 {
    int i;
    int lo, hi;
-   const unsigned char *cache;
-
-   LM++;
-   cache = m->cache.bits + m->cache.index[LM*m->nbEBands+band];
 
    lo = 0;
    hi = cache[0];
    bits--;
+   /*
+   The target bit count is data-dependent, so the midpoint compare was a
+   mispredict on nearly every step; masked updates lower to conditional
+   moves instead.
+   */
    for (i=0;i<6;i++)
    {
       int mid = (lo+hi+1)>>1;
-
-      if ((int)cache[mid] >= bits)
-         hi = mid;
-      else
-         lo = mid;
+      int ge = -((int)cache[mid] >= bits);
+      hi = (mid&ge)|(hi&~ge);
+      lo = (lo&ge)|(mid&~ge);
+   }
+   {
+      int sel = -(bits-(lo == 0 ? -1 : (int)cache[lo]) <= (int)cache[hi]-bits);
+      return (lo&sel)|(hi&~sel);
    }
-   if (bits- (lo == 0 ? -1 : (int)cache[lo]) <= (int)cache[hi]-bits)
-      return lo;
-   else
-      return hi;
 }
 
-static inline int pulses2bits(const OpusCustomMode *m, int band, int LM, int pulses)
+static inline int pulses2bits_cache(const unsigned char *cache, int pulses)
 {
-   const unsigned char *cache;
-
-   LM++;
-   cache = m->cache.bits + m->cache.index[LM*m->nbEBands+band];
    return pulses == 0 ? 0 : cache[pulses]+1;
 }
+
+static inline int bits2pulses(const OpusCustomMode *m, int band, int LM, int bits)
+{
+   return bits2pulses_cache(m->cache.bits + m->cache.index[(LM+1)*m->nbEBands+band], bits);
+}
+
+static inline int pulses2bits(const OpusCustomMode *m, int band, int LM, int pulses)
+{
+   return pulses2bits_cache(m->cache.bits + m->cache.index[(LM+1)*m->nbEBands+band], pulses);
+}
 int clt_compute_allocation(const OpusCustomMode *m, int start, int end, const int *offsets, const int *cap, int alloc_trim, int *intensity, int *dual_stereo,
       opus_int32 total, opus_int32 *balance, int *pulses, int *ebits, int *fine_priority, int C, int LM, ec_ctx *ec, int encode, int prev, int signalBandwidth);
 
@@ -1726,6 +2197,12 @@ static const unsigned char band_allocation[] = {
 
 
 
+/*
+Cache-line aligned: the overlap-add in the inverse MDCT streams this table
+from both ends every frame, and alignment keeps each half starting on a
+fresh line for the vectorized loads.
+*/
+__attribute__((aligned(64)))
 static const opus_val16 window120[120] = {
 6.7286966e-05f, 0.00060551348f, 0.0016815970f, 0.0032947962f, 0.0054439943f,
 0.0081276923f, 0.011344001f, 0.015090633f, 0.019364886f, 0.024163635f,
@@ -1816,6 +2293,7 @@ static const unsigned char cache_caps50[168] = {
 
 
 
+__attribute__((aligned(64)))
 static const kiss_twiddle_cpx fft_twiddles48000_960[480] = {
 {1.0000000f, -0.0000000f}, {0.99991433f, -0.013089596f},
 {0.99965732f, -0.026176948f}, {0.99922904f, -0.039259816f},
@@ -2059,6 +2537,260 @@ static const kiss_twiddle_cpx fft_twiddles48000_960[480] = {
 {0.99965732f, 0.026176948f}, {0.99991433f, 0.013089596f},
 };
 
+/*
+The same twiddles split into separate cosine and sine planes. The scalar
+butterflies keep using the interleaved pairs above, whose .r/.i sit on one
+line per access; vector stages load straight runs of cosines or sines from
+these instead of deinterleaving the pair layout with shuffles.
+*/
+__attribute__((aligned(64)))
+static const float fft_twiddles48000_960_cos[480] = {
+1.0000000f,0.99991433f,0.99965732f,0.99922904f,
+0.99862953f,0.99785892f,0.99691733f,0.99580493f,
+0.99452190f,0.99306846f,0.99144486f,0.98965139f,
+0.98768834f,0.98555606f,0.98325491f,0.98078528f,
+0.97814760f,0.97534232f,0.97236992f,0.96923091f,
+0.96592583f,0.96245524f,0.95881973f,0.95501994f,
+0.95105652f,0.94693013f,0.94264149f,0.93819134f,
+0.93358043f,0.92880955f,0.92387953f,0.91879121f,
+0.91354546f,0.90814317f,0.90258528f,0.89687274f,
+0.89100652f,0.88498764f,0.87881711f,0.87249601f,
+0.86602540f,0.85940641f,0.85264016f,0.84572782f,
+0.83867057f,0.83146961f,0.82412619f,0.81664156f,
+0.80901699f,0.80125381f,0.79335334f,0.78531693f,
+0.77714596f,0.76884183f,0.76040597f,0.75183981f,
+0.74314483f,0.73432251f,0.72537437f,0.71630194f,
+0.70710678f,0.69779046f,0.68835458f,0.67880075f,
+0.66913061f,0.65934582f,0.64944805f,0.63943900f,
+0.62932039f,0.61909395f,0.60876143f,0.59832460f,
+0.58778525f,0.57714519f,0.56640624f,0.55557023f,
+0.54463904f,0.53361452f,0.52249856f,0.51129309f,
+0.50000000f,0.48862124f,0.47715876f,0.46561452f,
+0.45399050f,0.44228869f,0.43051110f,0.41865974f,
+0.40673664f,0.39474386f,0.38268343f,0.37055744f,
+0.35836795f,0.34611706f,0.33380686f,0.32143947f,
+0.30901699f,0.29654157f,0.28401534f,0.27144045f,
+0.25881905f,0.24615329f,0.23344536f,0.22069744f,
+0.20791169f,0.19509032f,0.18223553f,0.16934950f,
+0.15643447f,0.14349262f,0.13052619f,0.11753740f,
+0.10452846f,0.091501619f,0.078459096f,0.065403129f,
+0.052335956f,0.039259816f,0.026176948f,0.013089596f,
+6.1230318e-17f,-0.013089596f,-0.026176948f,-0.039259816f,
+-0.052335956f,-0.065403129f,-0.078459096f,-0.091501619f,
+-0.10452846f,-0.11753740f,-0.13052619f,-0.14349262f,
+-0.15643447f,-0.16934950f,-0.18223553f,-0.19509032f,
+-0.20791169f,-0.22069744f,-0.23344536f,-0.24615329f,
+-0.25881905f,-0.27144045f,-0.28401534f,-0.29654157f,
+-0.30901699f,-0.32143947f,-0.33380686f,-0.34611706f,
+-0.35836795f,-0.37055744f,-0.38268343f,-0.39474386f,
+-0.40673664f,-0.41865974f,-0.43051110f,-0.44228869f,
+-0.45399050f,-0.46561452f,-0.47715876f,-0.48862124f,
+-0.50000000f,-0.51129309f,-0.52249856f,-0.53361452f,
+-0.54463904f,-0.55557023f,-0.56640624f,-0.57714519f,
+-0.58778525f,-0.59832460f,-0.60876143f,-0.61909395f,
+-0.62932039f,-0.63943900f,-0.64944805f,-0.65934582f,
+-0.66913061f,-0.67880075f,-0.68835458f,-0.69779046f,
+-0.70710678f,-0.71630194f,-0.72537437f,-0.73432251f,
+-0.74314483f,-0.75183981f,-0.76040597f,-0.76884183f,
+-0.77714596f,-0.78531693f,-0.79335334f,-0.80125381f,
+-0.80901699f,-0.81664156f,-0.82412619f,-0.83146961f,
+-0.83867057f,-0.84572782f,-0.85264016f,-0.85940641f,
+-0.86602540f,-0.87249601f,-0.87881711f,-0.88498764f,
+-0.89100652f,-0.89687274f,-0.90258528f,-0.90814317f,
+-0.91354546f,-0.91879121f,-0.92387953f,-0.92880955f,
+-0.93358043f,-0.93819134f,-0.94264149f,-0.94693013f,
+-0.95105652f,-0.95501994f,-0.95881973f,-0.96245524f,
+-0.96592583f,-0.96923091f,-0.97236992f,-0.97534232f,
+-0.97814760f,-0.98078528f,-0.98325491f,-0.98555606f,
+-0.98768834f,-0.98965139f,-0.99144486f,-0.99306846f,
+-0.99452190f,-0.99580493f,-0.99691733f,-0.99785892f,
+-0.99862953f,-0.99922904f,-0.99965732f,-0.99991433f,
+-1.0000000f,-0.99991433f,-0.99965732f,-0.99922904f,
+-0.99862953f,-0.99785892f,-0.99691733f,-0.99580493f,
+-0.99452190f,-0.99306846f,-0.99144486f,-0.98965139f,
+-0.98768834f,-0.98555606f,-0.98325491f,-0.98078528f,
+-0.97814760f,-0.97534232f,-0.97236992f,-0.96923091f,
+-0.96592583f,-0.96245524f,-0.95881973f,-0.95501994f,
+-0.95105652f,-0.94693013f,-0.94264149f,-0.93819134f,
+-0.93358043f,-0.92880955f,-0.92387953f,-0.91879121f,
+-0.91354546f,-0.90814317f,-0.90258528f,-0.89687274f,
+-0.89100652f,-0.88498764f,-0.87881711f,-0.87249601f,
+-0.86602540f,-0.85940641f,-0.85264016f,-0.84572782f,
+-0.83867057f,-0.83146961f,-0.82412619f,-0.81664156f,
+-0.80901699f,-0.80125381f,-0.79335334f,-0.78531693f,
+-0.77714596f,-0.76884183f,-0.76040597f,-0.75183981f,
+-0.74314483f,-0.73432251f,-0.72537437f,-0.71630194f,
+-0.70710678f,-0.69779046f,-0.68835458f,-0.67880075f,
+-0.66913061f,-0.65934582f,-0.64944805f,-0.63943900f,
+-0.62932039f,-0.61909395f,-0.60876143f,-0.59832460f,
+-0.58778525f,-0.57714519f,-0.56640624f,-0.55557023f,
+-0.54463904f,-0.53361452f,-0.52249856f,-0.51129309f,
+-0.50000000f,-0.48862124f,-0.47715876f,-0.46561452f,
+-0.45399050f,-0.44228869f,-0.43051110f,-0.41865974f,
+-0.40673664f,-0.39474386f,-0.38268343f,-0.37055744f,
+-0.35836795f,-0.34611706f,-0.33380686f,-0.32143947f,
+-0.30901699f,-0.29654157f,-0.28401534f,-0.27144045f,
+-0.25881905f,-0.24615329f,-0.23344536f,-0.22069744f,
+-0.20791169f,-0.19509032f,-0.18223553f,-0.16934950f,
+-0.15643447f,-0.14349262f,-0.13052619f,-0.11753740f,
+-0.10452846f,-0.091501619f,-0.078459096f,-0.065403129f,
+-0.052335956f,-0.039259816f,-0.026176948f,-0.013089596f,
+-1.8369095e-16f,0.013089596f,0.026176948f,0.039259816f,
+0.052335956f,0.065403129f,0.078459096f,0.091501619f,
+0.10452846f,0.11753740f,0.13052619f,0.14349262f,
+0.15643447f,0.16934950f,0.18223553f,0.19509032f,
+0.20791169f,0.22069744f,0.23344536f,0.24615329f,
+0.25881905f,0.27144045f,0.28401534f,0.29654157f,
+0.30901699f,0.32143947f,0.33380686f,0.34611706f,
+0.35836795f,0.37055744f,0.38268343f,0.39474386f,
+0.40673664f,0.41865974f,0.43051110f,0.44228869f,
+0.45399050f,0.46561452f,0.47715876f,0.48862124f,
+0.50000000f,0.51129309f,0.52249856f,0.53361452f,
+0.54463904f,0.55557023f,0.56640624f,0.57714519f,
+0.58778525f,0.59832460f,0.60876143f,0.61909395f,
+0.62932039f,0.63943900f,0.64944805f,0.65934582f,
+0.66913061f,0.67880075f,0.68835458f,0.69779046f,
+0.70710678f,0.71630194f,0.72537437f,0.73432251f,
+0.74314483f,0.75183981f,0.76040597f,0.76884183f,
+0.77714596f,0.78531693f,0.79335334f,0.80125381f,
+0.80901699f,0.81664156f,0.82412619f,0.83146961f,
+0.83867057f,0.84572782f,0.85264016f,0.85940641f,
+0.86602540f,0.87249601f,0.87881711f,0.88498764f,
+0.89100652f,0.89687274f,0.90258528f,0.90814317f,
+0.91354546f,0.91879121f,0.92387953f,0.92880955f,
+0.93358043f,0.93819134f,0.94264149f,0.94693013f,
+0.95105652f,0.95501994f,0.95881973f,0.96245524f,
+0.96592583f,0.96923091f,0.97236992f,0.97534232f,
+0.97814760f,0.98078528f,0.98325491f,0.98555606f,
+0.98768834f,0.98965139f,0.99144486f,0.99306846f,
+0.99452190f,0.99580493f,0.99691733f,0.99785892f,
+0.99862953f,0.99922904f,0.99965732f,0.99991433f
+};
+
+__attribute__((aligned(64)))
+static const float fft_twiddles48000_960_sin[480] = {
+-0.0000000f,-0.013089596f,-0.026176948f,-0.039259816f,
+-0.052335956f,-0.065403129f,-0.078459096f,-0.091501619f,
+-0.10452846f,-0.11753740f,-0.13052619f,-0.14349262f,
+-0.15643447f,-0.16934950f,-0.18223553f,-0.19509032f,
+-0.20791169f,-0.22069744f,-0.23344536f,-0.24615329f,
+-0.25881905f,-0.27144045f,-0.28401534f,-0.29654157f,
+-0.30901699f,-0.32143947f,-0.33380686f,-0.34611706f,
+-0.35836795f,-0.37055744f,-0.38268343f,-0.39474386f,
+-0.40673664f,-0.41865974f,-0.43051110f,-0.44228869f,
+-0.45399050f,-0.46561452f,-0.47715876f,-0.48862124f,
+-0.50000000f,-0.51129309f,-0.52249856f,-0.53361452f,
+-0.54463904f,-0.55557023f,-0.56640624f,-0.57714519f,
+-0.58778525f,-0.59832460f,-0.60876143f,-0.61909395f,
+-0.62932039f,-0.63943900f,-0.64944805f,-0.65934582f,
+-0.66913061f,-0.67880075f,-0.68835458f,-0.69779046f,
+-0.70710678f,-0.71630194f,-0.72537437f,-0.73432251f,
+-0.74314483f,-0.75183981f,-0.76040597f,-0.76884183f,
+-0.77714596f,-0.78531693f,-0.79335334f,-0.80125381f,
+-0.80901699f,-0.81664156f,-0.82412619f,-0.83146961f,
+-0.83867057f,-0.84572782f,-0.85264016f,-0.85940641f,
+-0.86602540f,-0.87249601f,-0.87881711f,-0.88498764f,
+-0.89100652f,-0.89687274f,-0.90258528f,-0.90814317f,
+-0.91354546f,-0.91879121f,-0.92387953f,-0.92880955f,
+-0.93358043f,-0.93819134f,-0.94264149f,-0.94693013f,
+-0.95105652f,-0.95501994f,-0.95881973f,-0.96245524f,
+-0.96592583f,-0.96923091f,-0.97236992f,-0.97534232f,
+-0.97814760f,-0.98078528f,-0.98325491f,-0.98555606f,
+-0.98768834f,-0.98965139f,-0.99144486f,-0.99306846f,
+-0.99452190f,-0.99580493f,-0.99691733f,-0.99785892f,
+-0.99862953f,-0.99922904f,-0.99965732f,-0.99991433f,
+-1.0000000f,-0.99991433f,-0.99965732f,-0.99922904f,
+-0.99862953f,-0.99785892f,-0.99691733f,-0.99580493f,
+-0.99452190f,-0.99306846f,-0.99144486f,-0.98965139f,
+-0.98768834f,-0.98555606f,-0.98325491f,-0.98078528f,
+-0.97814760f,-0.97534232f,-0.97236992f,-0.96923091f,
+-0.96592583f,-0.96245524f,-0.95881973f,-0.95501994f,
+-0.95105652f,-0.94693013f,-0.94264149f,-0.93819134f,
+-0.93358043f,-0.92880955f,-0.92387953f,-0.91879121f,
+-0.91354546f,-0.90814317f,-0.90258528f,-0.89687274f,
+-0.89100652f,-0.88498764f,-0.87881711f,-0.87249601f,
+-0.86602540f,-0.85940641f,-0.85264016f,-0.84572782f,
+-0.83867057f,-0.83146961f,-0.82412619f,-0.81664156f,
+-0.80901699f,-0.80125381f,-0.79335334f,-0.78531693f,
+-0.77714596f,-0.76884183f,-0.76040597f,-0.75183981f,
+-0.74314483f,-0.73432251f,-0.72537437f,-0.71630194f,
+-0.70710678f,-0.69779046f,-0.68835458f,-0.67880075f,
+-0.66913061f,-0.65934582f,-0.64944805f,-0.63943900f,
+-0.62932039f,-0.61909395f,-0.60876143f,-0.59832460f,
+-0.58778525f,-0.57714519f,-0.56640624f,-0.55557023f,
+-0.54463904f,-0.53361452f,-0.52249856f,-0.51129309f,
+-0.50000000f,-0.48862124f,-0.47715876f,-0.46561452f,
+-0.45399050f,-0.44228869f,-0.43051110f,-0.41865974f,
+-0.40673664f,-0.39474386f,-0.38268343f,-0.37055744f,
+-0.35836795f,-0.34611706f,-0.33380686f,-0.32143947f,
+-0.30901699f,-0.29654157f,-0.28401534f,-0.27144045f,
+-0.25881905f,-0.24615329f,-0.23344536f,-0.22069744f,
+-0.20791169f,-0.19509032f,-0.18223553f,-0.16934950f,
+-0.15643447f,-0.14349262f,-0.13052619f,-0.11753740f,
+-0.10452846f,-0.091501619f,-0.078459096f,-0.065403129f,
+-0.052335956f,-0.039259816f,-0.026176948f,-0.013089596f,
+-1.2246064e-16f,0.013089596f,0.026176948f,0.039259816f,
+0.052335956f,0.065403129f,0.078459096f,0.091501619f,
+0.10452846f,0.11753740f,0.13052619f,0.14349262f,
+0.15643447f,0.16934950f,0.18223553f,0.19509032f,
+0.20791169f,0.22069744f,0.23344536f,0.24615329f,
+0.25881905f,0.27144045f,0.28401534f,0.29654157f,
+0.30901699f,0.32143947f,0.33380686f,0.34611706f,
+0.35836795f,0.37055744f,0.38268343f,0.39474386f,
+0.40673664f,0.41865974f,0.43051110f,0.44228869f,
+0.45399050f,0.46561452f,0.47715876f,0.48862124f,
+0.50000000f,0.51129309f,0.52249856f,0.53361452f,
+0.54463904f,0.55557023f,0.56640624f,0.57714519f,
+0.58778525f,0.59832460f,0.60876143f,0.61909395f,
+0.62932039f,0.63943900f,0.64944805f,0.65934582f,
+0.66913061f,0.67880075f,0.68835458f,0.69779046f,
+0.70710678f,0.71630194f,0.72537437f,0.73432251f,
+0.74314483f,0.75183981f,0.76040597f,0.76884183f,
+0.77714596f,0.78531693f,0.79335334f,0.80125381f,
+0.80901699f,0.81664156f,0.82412619f,0.83146961f,
+0.83867057f,0.84572782f,0.85264016f,0.85940641f,
+0.86602540f,0.87249601f,0.87881711f,0.88498764f,
+0.89100652f,0.89687274f,0.90258528f,0.90814317f,
+0.91354546f,0.91879121f,0.92387953f,0.92880955f,
+0.93358043f,0.93819134f,0.94264149f,0.94693013f,
+0.95105652f,0.95501994f,0.95881973f,0.96245524f,
+0.96592583f,0.96923091f,0.97236992f,0.97534232f,
+0.97814760f,0.98078528f,0.98325491f,0.98555606f,
+0.98768834f,0.98965139f,0.99144486f,0.99306846f,
+0.99452190f,0.99580493f,0.99691733f,0.99785892f,
+0.99862953f,0.99922904f,0.99965732f,0.99991433f,
+1.0000000f,0.99991433f,0.99965732f,0.99922904f,
+0.99862953f,0.99785892f,0.99691733f,0.99580493f,
+0.99452190f,0.99306846f,0.99144486f,0.98965139f,
+0.98768834f,0.98555606f,0.98325491f,0.98078528f,
+0.97814760f,0.97534232f,0.97236992f,0.96923091f,
+0.96592583f,0.96245524f,0.95881973f,0.95501994f,
+0.95105652f,0.94693013f,0.94264149f,0.93819134f,
+0.93358043f,0.92880955f,0.92387953f,0.91879121f,
+0.91354546f,0.90814317f,0.90258528f,0.89687274f,
+0.89100652f,0.88498764f,0.87881711f,0.87249601f,
+0.86602540f,0.85940641f,0.85264016f,0.84572782f,
+0.83867057f,0.83146961f,0.82412619f,0.81664156f,
+0.80901699f,0.80125381f,0.79335334f,0.78531693f,
+0.77714596f,0.76884183f,0.76040597f,0.75183981f,
+0.74314483f,0.73432251f,0.72537437f,0.71630194f,
+0.70710678f,0.69779046f,0.68835458f,0.67880075f,
+0.66913061f,0.65934582f,0.64944805f,0.63943900f,
+0.62932039f,0.61909395f,0.60876143f,0.59832460f,
+0.58778525f,0.57714519f,0.56640624f,0.55557023f,
+0.54463904f,0.53361452f,0.52249856f,0.51129309f,
+0.50000000f,0.48862124f,0.47715876f,0.46561452f,
+0.45399050f,0.44228869f,0.43051110f,0.41865974f,
+0.40673664f,0.39474386f,0.38268343f,0.37055744f,
+0.35836795f,0.34611706f,0.33380686f,0.32143947f,
+0.30901699f,0.29654157f,0.28401534f,0.27144045f,
+0.25881905f,0.24615329f,0.23344536f,0.22069744f,
+0.20791169f,0.19509032f,0.18223553f,0.16934950f,
+0.15643447f,0.14349262f,0.13052619f,0.11753740f,
+0.10452846f,0.091501619f,0.078459096f,0.065403129f,
+0.052335956f,0.039259816f,0.026176948f,0.013089596f
+};
+
 
 static const opus_int16 fft_bitrev480[480] = {
 0, 96, 192, 288, 384, 32, 128, 224, 320, 416, 64, 160, 256, 352, 448,
@@ -2151,13 +2883,8 @@ static const kiss_fft_state fft_state48000_960_0 = {
 {5, 96, 3, 32, 4, 8, 2, 4, 4, 1, 0, 0, 0, 0, 0, 0, },
 fft_bitrev480,
 fft_twiddles48000_960,
-
-
-
-
-((void *)0)
-   ,
-
+fft_twiddles48000_960_cos,
+fft_twiddles48000_960_sin,
 };
 
 
@@ -2170,13 +2897,8 @@ static const kiss_fft_state fft_state48000_960_1 = {
 {5, 48, 3, 16, 4, 4, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, },
 fft_bitrev240,
 fft_twiddles48000_960,
-
-
-
-
-((void *)0)
-   ,
-
+fft_twiddles48000_960_cos,
+fft_twiddles48000_960_sin,
 };
 
 
@@ -2189,13 +2911,8 @@ static const kiss_fft_state fft_state48000_960_2 = {
 {5, 24, 3, 8, 2, 4, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, },
 fft_bitrev120,
 fft_twiddles48000_960,
-
-
-
-
-((void *)0)
-   ,
-
+fft_twiddles48000_960_cos,
+fft_twiddles48000_960_sin,
 };
 
 
@@ -2208,13 +2925,8 @@ static const kiss_fft_state fft_state48000_960_3 = {
 {5, 12, 3, 4, 4, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, },
 fft_bitrev60,
 fft_twiddles48000_960,
-
-
-
-
-((void *)0)
-   ,
-
+fft_twiddles48000_960_cos,
+fft_twiddles48000_960_sin,
 };
 
 
@@ -2222,6 +2934,7 @@ fft_twiddles48000_960,
 
 
 
+__attribute__((aligned(64)))
 static const opus_val16 mdct_twiddles960[1800] = {
 0.99999994f, 0.99999321f, 0.99997580f, 0.99994773f, 0.99990886f,
 0.99985933f, 0.99979913f, 0.99972820f, 0.99964654f, 0.99955416f,
@@ -2588,20 +3301,20 @@ static const opus_val16 mdct_twiddles960[1800] = {
 
 static const OpusCustomMode mode48000_960_120 = {
 48000,
-120,
 21,
 21,
-{0.85000610f, 0.0000000f, 1.0000000f, 1.0000000f, },
-eband5ms,
-3,
+120,
 8,
+3,
 120,
+eband5ms,
+logN400,
+{392, cache_index50, cache_bits50, cache_caps50},
+{0.85000610f, 0.0000000f, 1.0000000f, 1.0000000f, },
 11,
 band_allocation,
-logN400,
 window120,
 {1920, 3, {&fft_state48000_960_0, &fft_state48000_960_1, &fft_state48000_960_2, &fft_state48000_960_3, }, mdct_twiddles960},
-{392, cache_index50, cache_bits50, cache_caps50},
 };
 
 
@@ -2726,24 +3439,30 @@ static void compute_allocation_table(OpusCustomMode *mode)
    }
 
 
-   for (i=0;i<11;i++)
+   /*
+   The reference band eband5ms[k] bracketing band j is the same for all 11
+   allocation rows, and both band lists are monotone, so one merge cursor
+   over j finds every bracket instead of a fresh scan per (row, band) pair.
+   The cursor can never stop at k==0 because eband5ms[0] is 0.
+   */
    {
+      int k = 0;
       for (j=0;j<mode->nbEBands;j++)
       {
-         int k;
-         for (k=0;k<maxBands;k++)
-         {
-            if (400*(opus_int32)eband5ms[k] > mode->eBands[j]*(opus_int32)mode->Fs/mode->shortMdctSize)
-               break;
-         }
+         opus_int32 freq = mode->eBands[j]*(opus_int32)mode->Fs/mode->shortMdctSize;
+         while (k<maxBands && 400*(opus_int32)eband5ms[k] <= freq)
+            k++;
          if (k>maxBands-1)
-            allocVectors[i*mode->nbEBands+j] = band_allocation[i*maxBands + maxBands-1];
-         else {
+         {
+            for (i=0;i<11;i++)
+               allocVectors[i*mode->nbEBands+j] = band_allocation[i*maxBands + maxBands-1];
+         } else {
             opus_int32 a0, a1;
-            a1 = mode->eBands[j]*(opus_int32)mode->Fs/mode->shortMdctSize - 400*(opus_int32)eband5ms[k-1];
-            a0 = 400*(opus_int32)eband5ms[k] - mode->eBands[j]*(opus_int32)mode->Fs/mode->shortMdctSize;
-            allocVectors[i*mode->nbEBands+j] = (a0*band_allocation[i*maxBands+k-1]
-                                             + a1*band_allocation[i*maxBands+k])/(a0+a1);
+            a1 = freq - 400*(opus_int32)eband5ms[k-1];
+            a0 = 400*(opus_int32)eband5ms[k] - freq;
+            for (i=0;i<11;i++)
+               allocVectors[i*mode->nbEBands+j] = (a0*band_allocation[i*maxBands+k-1]
+                                                + a1*band_allocation[i*maxBands+k])/(a0+a1);
          }
       }
    }
@@ -2763,7 +3482,7 @@ OpusCustomMode *opus_custom_mode_create(opus_int32 Fs, int frame_size, int *erro
    opus_val16 *window;
    opus_int16 *logN;
    int LM;
-   int arch = opus_select_arch();
+   int arch;
    ;
 
 
@@ -2786,11 +3505,14 @@ OpusCustomMode *opus_custom_mode_create(opus_int32 Fs, int frame_size, int *erro
          }
       }
    }
+   /* Only the build-a-mode path below needs the arch probe; the static-mode
+      hits above return without paying for it. */
+   arch = opus_select_arch();
    if (Fs < 8000 || Fs > 96000)
    {
       if (error)
          *error = -1;
-      return 
+      return
             ((void *)0)
                 ;
    }
@@ -3048,6 +3770,18 @@ static void kf_bfly2(
    }
 }
 
+#if defined(DR_OPUS_SUPPORT_NEON)
+/* Gather four floats at a constant stride into one vector. */
+static DR_OPUS_INLINE float32x4_t kf_load_stride4(const float *p, size_t stride)
+{
+   float32x4_t v = vdupq_n_f32(p[0]);
+   v = vsetq_lane_f32(p[stride], v, 1);
+   v = vsetq_lane_f32(p[2*stride], v, 2);
+   v = vsetq_lane_f32(p[3*stride], v, 3);
+   return v;
+}
+#endif
+
 static void kf_bfly4(
                      kiss_fft_cpx * Fout,
                      const size_t fstride,
@@ -3061,7 +3795,55 @@ static void kf_bfly4(
 
    if (m==1)
    {
-
+      /*
+      The twiddle-free stage: each butterfly is add/sub/swap over four
+      consecutive complex values, so it vectorizes in place over the
+      interleaved layout. The vector bodies evaluate the same two-operand
+      sums as the scalar code (a-b and a+(-b) are the same IEEE operation),
+      so the results are bit-identical.
+      */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      {
+         const __m128 sgn = _mm_castsi128_ps(_mm_set_epi32(0, (int)0x80000000, (int)0x80000000, 0));
+         for (i=0;i<N;i++)
+         {
+            __m128 A = _mm_loadu_ps((const float*)Fout);     /* F0.r F0.i F1.r F1.i */
+            __m128 B = _mm_loadu_ps((const float*)Fout+4);   /* F2.r F2.i F3.r F3.i */
+            __m128 T = _mm_add_ps(A, B);                     /* F0+F2 | F1+F3 */
+            __m128 S = _mm_sub_ps(A, B);                     /* F0-F2 | F1-F3 */
+            __m128 T2 = _mm_shuffle_ps(T, T, _MM_SHUFFLE(1,0,3,2));
+            __m128 U = _mm_add_ps(T, T2);                    /* new F0 in low half */
+            __m128 V = _mm_sub_ps(T, T2);                    /* new F2 in low half */
+            __m128 P = _mm_shuffle_ps(S, S, _MM_SHUFFLE(1,0,1,0)); /* s0 | s0 */
+            __m128 Q = _mm_shuffle_ps(S, S, _MM_SHUFFLE(2,3,2,3)); /* s1.i s1.r | s1.i s1.r */
+            __m128 W = _mm_add_ps(P, _mm_xor_ps(Q, sgn));    /* new F1 | new F3 */
+            _mm_storeu_ps((float*)Fout,   _mm_shuffle_ps(U, W, _MM_SHUFFLE(1,0,1,0)));
+            _mm_storeu_ps((float*)Fout+4, _mm_shuffle_ps(V, W, _MM_SHUFFLE(3,2,1,0)));
+            Fout+=4;
+         }
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      {
+         const uint32x4_t sgn = {0, 0x80000000u, 0x80000000u, 0};
+         for (i=0;i<N;i++)
+         {
+            float32x4_t A = vld1q_f32((const float*)Fout);
+            float32x4_t B = vld1q_f32((const float*)Fout+4);
+            float32x4_t T = vaddq_f32(A, B);
+            float32x4_t S = vsubq_f32(A, B);
+            float32x4_t T2 = vextq_f32(T, T, 2);
+            float32x4_t U = vaddq_f32(T, T2);
+            float32x4_t V = vsubq_f32(T, T2);
+            float32x2_t s0 = vget_low_f32(S);
+            float32x2_t s1sw = vrev64_f32(vget_high_f32(S));
+            float32x4_t Q = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vcombine_f32(s1sw, s1sw)), sgn));
+            float32x4_t W = vaddq_f32(vcombine_f32(s0, s0), Q);
+            vst1q_f32((float*)Fout,   vcombine_f32(vget_low_f32(U), vget_low_f32(W)));
+            vst1q_f32((float*)Fout+4, vcombine_f32(vget_low_f32(V), vget_high_f32(W)));
+            Fout+=4;
+         }
+      }
+#else
       for (i=0;i<N;i++)
       {
          kiss_fft_cpx scratch0, scratch1;
@@ -3079,6 +3861,7 @@ static void kf_bfly4(
          Fout[3].i = ((scratch0.i)+(scratch1.r));
          Fout+=4;
       }
+#endif
    } else {
       int j;
       kiss_fft_cpx scratch[6];
@@ -3091,7 +3874,135 @@ static void kf_bfly4(
          Fout = Fout_beg + i*mm;
          tw3 = tw2 = tw1 = st->twiddles;
 
-         for (j=0;j<m;j++)
+         j=0;
+         /*
+         Four butterflies at a time over the interleaved buffer. The twiddle
+         lanes come from the split cos/sin planes at the same strided indices
+         the scalar pointers would visit, and every lane evaluates the exact
+         mul/add/sub sequence of the scalar body (no FMA, no reassociation),
+         so the results are bit-identical. Within a block all loads precede
+         all stores, and the four m-offsets cannot collide because j+3 < m.
+         */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         {
+            const float *tc = st->twiddles_cos;
+            const float *tsn = st->twiddles_sin;
+            size_t k1 = 0, k2 = 0, k3 = 0;
+            for (;j+4<=m;j+=4)
+            {
+               __m128 a0 = _mm_loadu_ps((const float*)(Fout+j));
+               __m128 a1 = _mm_loadu_ps((const float*)(Fout+j)+4);
+               __m128 b0 = _mm_loadu_ps((const float*)(Fout+j+m));
+               __m128 b1 = _mm_loadu_ps((const float*)(Fout+j+m)+4);
+               __m128 c0 = _mm_loadu_ps((const float*)(Fout+j+m2));
+               __m128 c1 = _mm_loadu_ps((const float*)(Fout+j+m2)+4);
+               __m128 d0 = _mm_loadu_ps((const float*)(Fout+j+m3));
+               __m128 d1 = _mm_loadu_ps((const float*)(Fout+j+m3)+4);
+               __m128 r0 = _mm_shuffle_ps(a0,a1,_MM_SHUFFLE(2,0,2,0));
+               __m128 q0 = _mm_shuffle_ps(a0,a1,_MM_SHUFFLE(3,1,3,1));
+               __m128 r1 = _mm_shuffle_ps(b0,b1,_MM_SHUFFLE(2,0,2,0));
+               __m128 q1 = _mm_shuffle_ps(b0,b1,_MM_SHUFFLE(3,1,3,1));
+               __m128 r2 = _mm_shuffle_ps(c0,c1,_MM_SHUFFLE(2,0,2,0));
+               __m128 q2 = _mm_shuffle_ps(c0,c1,_MM_SHUFFLE(3,1,3,1));
+               __m128 r3 = _mm_shuffle_ps(d0,d1,_MM_SHUFFLE(2,0,2,0));
+               __m128 q3 = _mm_shuffle_ps(d0,d1,_MM_SHUFFLE(3,1,3,1));
+               __m128 t1r = _mm_setr_ps(tc[k1],tc[k1+fstride],tc[k1+2*fstride],tc[k1+3*fstride]);
+               __m128 t1i = _mm_setr_ps(tsn[k1],tsn[k1+fstride],tsn[k1+2*fstride],tsn[k1+3*fstride]);
+               __m128 t2r = _mm_setr_ps(tc[k2],tc[k2+2*fstride],tc[k2+4*fstride],tc[k2+6*fstride]);
+               __m128 t2i = _mm_setr_ps(tsn[k2],tsn[k2+2*fstride],tsn[k2+4*fstride],tsn[k2+6*fstride]);
+               __m128 t3r = _mm_setr_ps(tc[k3],tc[k3+3*fstride],tc[k3+6*fstride],tc[k3+9*fstride]);
+               __m128 t3i = _mm_setr_ps(tsn[k3],tsn[k3+3*fstride],tsn[k3+6*fstride],tsn[k3+9*fstride]);
+               __m128 s0r = _mm_sub_ps(_mm_mul_ps(r1,t1r), _mm_mul_ps(q1,t1i));
+               __m128 s0i = _mm_add_ps(_mm_mul_ps(r1,t1i), _mm_mul_ps(q1,t1r));
+               __m128 s1r = _mm_sub_ps(_mm_mul_ps(r2,t2r), _mm_mul_ps(q2,t2i));
+               __m128 s1i = _mm_add_ps(_mm_mul_ps(r2,t2i), _mm_mul_ps(q2,t2r));
+               __m128 s2r = _mm_sub_ps(_mm_mul_ps(r3,t3r), _mm_mul_ps(q3,t3i));
+               __m128 s2i = _mm_add_ps(_mm_mul_ps(r3,t3i), _mm_mul_ps(q3,t3r));
+               __m128 s5r = _mm_sub_ps(r0,s1r);
+               __m128 s5i = _mm_sub_ps(q0,s1i);
+               __m128 s3r, s3i, s4r, s4i, o1r, o1i;
+               r0 = _mm_add_ps(r0,s1r);
+               q0 = _mm_add_ps(q0,s1i);
+               s3r = _mm_add_ps(s0r,s2r);
+               s3i = _mm_add_ps(s0i,s2i);
+               s4r = _mm_sub_ps(s0r,s2r);
+               s4i = _mm_sub_ps(s0i,s2i);
+               o1r = _mm_sub_ps(r0,s3r);
+               o1i = _mm_sub_ps(q0,s3i);
+               _mm_storeu_ps((float*)(Fout+j+m2),   _mm_unpacklo_ps(o1r,o1i));
+               _mm_storeu_ps((float*)(Fout+j+m2)+4, _mm_unpackhi_ps(o1r,o1i));
+               r0 = _mm_add_ps(r0,s3r);
+               q0 = _mm_add_ps(q0,s3i);
+               _mm_storeu_ps((float*)(Fout+j),   _mm_unpacklo_ps(r0,q0));
+               _mm_storeu_ps((float*)(Fout+j)+4, _mm_unpackhi_ps(r0,q0));
+               o1r = _mm_add_ps(s5r,s4i);
+               o1i = _mm_sub_ps(s5i,s4r);
+               _mm_storeu_ps((float*)(Fout+j+m),   _mm_unpacklo_ps(o1r,o1i));
+               _mm_storeu_ps((float*)(Fout+j+m)+4, _mm_unpackhi_ps(o1r,o1i));
+               o1r = _mm_sub_ps(s5r,s4i);
+               o1i = _mm_add_ps(s5i,s4r);
+               _mm_storeu_ps((float*)(Fout+j+m3),   _mm_unpacklo_ps(o1r,o1i));
+               _mm_storeu_ps((float*)(Fout+j+m3)+4, _mm_unpackhi_ps(o1r,o1i));
+               k1 += 4*fstride;
+               k2 += 8*fstride;
+               k3 += 12*fstride;
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         {
+            const float *tc = st->twiddles_cos;
+            const float *tsn = st->twiddles_sin;
+            size_t k1 = 0, k2 = 0, k3 = 0;
+            for (;j+4<=m;j+=4)
+            {
+               float32x4x2_t F0 = vld2q_f32((const float*)(Fout+j));
+               float32x4x2_t F1 = vld2q_f32((const float*)(Fout+j+m));
+               float32x4x2_t F2 = vld2q_f32((const float*)(Fout+j+m2));
+               float32x4x2_t F3 = vld2q_f32((const float*)(Fout+j+m3));
+               float32x4_t t1r = kf_load_stride4(tc+k1, fstride);
+               float32x4_t t1i = kf_load_stride4(tsn+k1, fstride);
+               float32x4_t t2r = kf_load_stride4(tc+k2, 2*fstride);
+               float32x4_t t2i = kf_load_stride4(tsn+k2, 2*fstride);
+               float32x4_t t3r = kf_load_stride4(tc+k3, 3*fstride);
+               float32x4_t t3i = kf_load_stride4(tsn+k3, 3*fstride);
+               float32x4_t s0r = vsubq_f32(vmulq_f32(F1.val[0],t1r), vmulq_f32(F1.val[1],t1i));
+               float32x4_t s0i = vaddq_f32(vmulq_f32(F1.val[0],t1i), vmulq_f32(F1.val[1],t1r));
+               float32x4_t s1r = vsubq_f32(vmulq_f32(F2.val[0],t2r), vmulq_f32(F2.val[1],t2i));
+               float32x4_t s1i = vaddq_f32(vmulq_f32(F2.val[0],t2i), vmulq_f32(F2.val[1],t2r));
+               float32x4_t s2r = vsubq_f32(vmulq_f32(F3.val[0],t3r), vmulq_f32(F3.val[1],t3i));
+               float32x4_t s2i = vaddq_f32(vmulq_f32(F3.val[0],t3i), vmulq_f32(F3.val[1],t3r));
+               float32x4_t s5r = vsubq_f32(F0.val[0],s1r);
+               float32x4_t s5i = vsubq_f32(F0.val[1],s1i);
+               float32x4_t r0 = vaddq_f32(F0.val[0],s1r);
+               float32x4_t q0 = vaddq_f32(F0.val[1],s1i);
+               float32x4_t s3r = vaddq_f32(s0r,s2r);
+               float32x4_t s3i = vaddq_f32(s0i,s2i);
+               float32x4_t s4r = vsubq_f32(s0r,s2r);
+               float32x4_t s4i = vsubq_f32(s0i,s2i);
+               float32x4x2_t o;
+               o.val[0] = vsubq_f32(r0,s3r);
+               o.val[1] = vsubq_f32(q0,s3i);
+               vst2q_f32((float*)(Fout+j+m2), o);
+               o.val[0] = vaddq_f32(r0,s3r);
+               o.val[1] = vaddq_f32(q0,s3i);
+               vst2q_f32((float*)(Fout+j), o);
+               o.val[0] = vaddq_f32(s5r,s4i);
+               o.val[1] = vsubq_f32(s5i,s4r);
+               vst2q_f32((float*)(Fout+j+m), o);
+               o.val[0] = vsubq_f32(s5r,s4i);
+               o.val[1] = vaddq_f32(s5i,s4r);
+               vst2q_f32((float*)(Fout+j+m3), o);
+               k1 += 4*fstride;
+               k2 += 8*fstride;
+               k3 += 12*fstride;
+            }
+         }
+#endif
+         Fout += j;
+         tw1 += (size_t)j*fstride;
+         tw2 += (size_t)j*fstride*2;
+         tw3 += (size_t)j*fstride*3;
+         for (;j<m;j++)
          {
             do{ (scratch[0]).r = (Fout[m]).r*(*tw1).r - (Fout[m]).i*(*tw1).i; (scratch[0]).i = (Fout[m]).r*(*tw1).i + (Fout[m]).i*(*tw1).r; }while(0);
             do{ (scratch[1]).r = (Fout[m2]).r*(*tw2).r - (Fout[m2]).i*(*tw2).i; (scratch[1]).i = (Fout[m2]).r*(*tw2).i + (Fout[m2]).i*(*tw2).r; }while(0);
@@ -3120,6 +4031,162 @@ static void kf_bfly4(
 
 
 
+/*
+Fused final pass for schedules ending radix-4 (m==1) then radix-2 (m==4),
+which is how kf_factor splits the odd power of two in the 480- and 120-point
+transforms. Each group of 8 consecutive complex values is self-contained
+across those two stages, so doing both while the group sits in registers
+saves a full store/reload of the buffer. Every arithmetic step is the exact
+sequence of the two scalar bodies it replaces (multiplying by 1, negating,
+and a+(-b) are all exact), so output is bit-identical to running the stages
+separately.
+*/
+static void kf_bfly8(
+                     kiss_fft_cpx * Fout,
+                     int N
+                    )
+{
+   int i;
+   const opus_val16 tw = (0.7071067812f);
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      const __m128 sgn = _mm_castsi128_ps(_mm_set_epi32(0, (int)0x80000000, (int)0x80000000, 0));
+      const __m128 neg3 = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, 0, 0));
+      const __m128 neg2 = _mm_castsi128_ps(_mm_set_epi32(0, (int)0x80000000, 0, 0));
+      const __m128 neg1 = _mm_castsi128_ps(_mm_set_epi32(0, 0, (int)0x80000000, 0));
+      const __m128 tw4 = _mm_set1_ps(tw);
+      const __m128 twn = _mm_setr_ps(0.f, 0.f, tw, -tw);
+      for (i=0;i<N;i++)
+      {
+         __m128 A = _mm_loadu_ps((const float*)Fout);
+         __m128 B = _mm_loadu_ps((const float*)Fout+4);
+         __m128 C = _mm_loadu_ps((const float*)Fout+8);
+         __m128 D = _mm_loadu_ps((const float*)Fout+12);
+         __m128 X01, X23, Y01, Y23;
+         __m128 T, S, T2, U, V, P, Q, W;
+         __m128 Z, t1, t2, Vs;
+         /* radix-4 on the two halves, results held in registers */
+         T = _mm_add_ps(A, B); S = _mm_sub_ps(A, B);
+         T2 = _mm_shuffle_ps(T, T, _MM_SHUFFLE(1,0,3,2));
+         U = _mm_add_ps(T, T2); V = _mm_sub_ps(T, T2);
+         P = _mm_shuffle_ps(S, S, _MM_SHUFFLE(1,0,1,0));
+         Q = _mm_shuffle_ps(S, S, _MM_SHUFFLE(2,3,2,3));
+         W = _mm_add_ps(P, _mm_xor_ps(Q, sgn));
+         X01 = _mm_shuffle_ps(U, W, _MM_SHUFFLE(1,0,1,0));
+         X23 = _mm_shuffle_ps(V, W, _MM_SHUFFLE(3,2,1,0));
+         T = _mm_add_ps(C, D); S = _mm_sub_ps(C, D);
+         T2 = _mm_shuffle_ps(T, T, _MM_SHUFFLE(1,0,3,2));
+         U = _mm_add_ps(T, T2); V = _mm_sub_ps(T, T2);
+         P = _mm_shuffle_ps(S, S, _MM_SHUFFLE(1,0,1,0));
+         Q = _mm_shuffle_ps(S, S, _MM_SHUFFLE(2,3,2,3));
+         W = _mm_add_ps(P, _mm_xor_ps(Q, sgn));
+         Y01 = _mm_shuffle_ps(U, W, _MM_SHUFFLE(1,0,1,0));
+         Y23 = _mm_shuffle_ps(V, W, _MM_SHUFFLE(3,2,1,0));
+         /* radix-2 with twiddles 1 and exp(-i*pi/4) on the 0/1 | 4/5 pairs */
+         Vs = _mm_xor_ps(_mm_shuffle_ps(Y01, Y01, _MM_SHUFFLE(2,3,1,0)), neg3);
+         Z = _mm_mul_ps(_mm_add_ps(Y01, Vs), tw4);
+         t1 = _mm_shuffle_ps(Y01, Z, _MM_SHUFFLE(3,2,1,0));
+         _mm_storeu_ps((float*)Fout,   _mm_add_ps(X01, t1));
+         _mm_storeu_ps((float*)Fout+8, _mm_sub_ps(X01, t1));
+         /* twiddles -i and -exp(i*pi/4) on the 2/3 | 6/7 pairs */
+         Vs = _mm_shuffle_ps(Y23, Y23, _MM_SHUFFLE(2,3,0,1));
+         Z = _mm_mul_ps(_mm_add_ps(Vs, _mm_xor_ps(Y23, neg2)), twn);
+         t2 = _mm_shuffle_ps(_mm_xor_ps(Vs, neg1), Z, _MM_SHUFFLE(3,2,1,0));
+         _mm_storeu_ps((float*)Fout+4,  _mm_add_ps(X23, t2));
+         _mm_storeu_ps((float*)Fout+12, _mm_sub_ps(X23, t2));
+         Fout += 8;
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   {
+      const uint32x4_t sgn = {0, 0x80000000u, 0x80000000u, 0};
+      const uint32x4_t neg3 = {0, 0, 0, 0x80000000u};
+      const uint32x4_t neg2 = {0, 0, 0x80000000u, 0};
+      const uint32x4_t neg1 = {0, 0x80000000u, 0, 0};
+      const float32x4_t twn = {0.f, 0.f, tw, -tw};
+      for (i=0;i<N;i++)
+      {
+         float32x4_t A = vld1q_f32((const float*)Fout);
+         float32x4_t B = vld1q_f32((const float*)Fout+4);
+         float32x4_t C = vld1q_f32((const float*)Fout+8);
+         float32x4_t D = vld1q_f32((const float*)Fout+12);
+         float32x4_t X01, X23, Y01, Y23;
+         float32x4_t T, S, T2, U, V, Q, W;
+         float32x4_t Z, t1, t2, Vs;
+         float32x2_t s0;
+         T = vaddq_f32(A, B); S = vsubq_f32(A, B);
+         T2 = vextq_f32(T, T, 2);
+         U = vaddq_f32(T, T2); V = vsubq_f32(T, T2);
+         s0 = vget_low_f32(S);
+         Q = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vcombine_f32(vrev64_f32(vget_high_f32(S)), vrev64_f32(vget_high_f32(S)))), sgn));
+         W = vaddq_f32(vcombine_f32(s0, s0), Q);
+         X01 = vcombine_f32(vget_low_f32(U), vget_low_f32(W));
+         X23 = vcombine_f32(vget_low_f32(V), vget_high_f32(W));
+         T = vaddq_f32(C, D); S = vsubq_f32(C, D);
+         T2 = vextq_f32(T, T, 2);
+         U = vaddq_f32(T, T2); V = vsubq_f32(T, T2);
+         s0 = vget_low_f32(S);
+         Q = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vcombine_f32(vrev64_f32(vget_high_f32(S)), vrev64_f32(vget_high_f32(S)))), sgn));
+         W = vaddq_f32(vcombine_f32(s0, s0), Q);
+         Y01 = vcombine_f32(vget_low_f32(U), vget_low_f32(W));
+         Y23 = vcombine_f32(vget_low_f32(V), vget_high_f32(W));
+         Vs = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vrev64q_f32(Y01)), neg3));
+         Z = vmulq_n_f32(vaddq_f32(Y01, Vs), tw);
+         t1 = vcombine_f32(vget_low_f32(Y01), vget_high_f32(Z));
+         vst1q_f32((float*)Fout,   vaddq_f32(X01, t1));
+         vst1q_f32((float*)Fout+8, vsubq_f32(X01, t1));
+         Vs = vrev64q_f32(Y23);
+         Z = vmulq_f32(vaddq_f32(Vs, vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(Y23), neg2))), twn);
+         t2 = vcombine_f32(vget_low_f32(vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(Vs), neg1))), vget_high_f32(Z));
+         vst1q_f32((float*)Fout+4,  vaddq_f32(X23, t2));
+         vst1q_f32((float*)Fout+12, vsubq_f32(X23, t2));
+         Fout += 8;
+      }
+   }
+#else
+   for (i=0;i<N;i++)
+   {
+      kiss_fft_cpx G[8];
+      kiss_fft_cpx scratch0, scratch1, t;
+      int h;
+      for (h=0;h<8;h+=4)
+      {
+         do { (scratch0).r=(Fout[h]).r-(Fout[h+2]).r; (scratch0).i=(Fout[h]).i-(Fout[h+2]).i; }while(0);
+         do { (G[h]).r=(Fout[h]).r+(Fout[h+2]).r; (G[h]).i=(Fout[h]).i+(Fout[h+2]).i; }while(0);
+         do { (scratch1).r=(Fout[h+1]).r+(Fout[h+3]).r; (scratch1).i=(Fout[h+1]).i+(Fout[h+3]).i; }while(0);
+         do { (G[h+2]).r=(G[h]).r-(scratch1).r; (G[h+2]).i=(G[h]).i-(scratch1).i; }while(0);
+         do { (G[h]).r += (scratch1).r; (G[h]).i += (scratch1).i; }while(0);
+         do { (scratch1).r=(Fout[h+1]).r-(Fout[h+3]).r; (scratch1).i=(Fout[h+1]).i-(Fout[h+3]).i; }while(0);
+
+         G[h+1].r = ((scratch0.r)+(scratch1.i));
+         G[h+1].i = ((scratch0.i)-(scratch1.r));
+         G[h+3].r = ((scratch0.r)-(scratch1.i));
+         G[h+3].i = ((scratch0.i)+(scratch1.r));
+      }
+
+      t = G[4];
+      do { (Fout[4]).r=(G[0]).r-(t).r; (Fout[4]).i=(G[0]).i-(t).i; }while(0);
+      do { (Fout[0]).r=(G[0]).r+(t).r; (Fout[0]).i=(G[0]).i+(t).i; }while(0);
+
+      t.r = ( (((G[5].r)+(G[5].i)))*(tw) );
+      t.i = ( (((G[5].i)-(G[5].r)))*(tw) );
+      do { (Fout[5]).r=(G[1]).r-(t).r; (Fout[5]).i=(G[1]).i-(t).i; }while(0);
+      do { (Fout[1]).r=(G[1]).r+(t).r; (Fout[1]).i=(G[1]).i+(t).i; }while(0);
+
+      t.r = G[6].i;
+      t.i = -G[6].r;
+      do { (Fout[6]).r=(G[2]).r-(t).r; (Fout[6]).i=(G[2]).i-(t).i; }while(0);
+      do { (Fout[2]).r=(G[2]).r+(t).r; (Fout[2]).i=(G[2]).i+(t).i; }while(0);
+
+      t.r = ( (((G[7].i)-(G[7].r)))*(tw) );
+      t.i = ( ((-(((G[7].i)+(G[7].r)))))*(tw) );
+      do { (Fout[7]).r=(G[3]).r-(t).r; (Fout[7]).i=(G[3]).i-(t).i; }while(0);
+      do { (Fout[3]).r=(G[3]).r+(t).r; (Fout[3]).i=(G[3]).i+(t).i; }while(0);
+      Fout += 8;
+   }
+#endif
+}
+
 static void kf_bfly3(
                      kiss_fft_cpx * Fout,
                      const size_t fstride,
@@ -3411,15 +4478,33 @@ kiss_fft_state *opus_fft_alloc_twiddles(int nfft,void * mem,size_t * lenmem,
                        )
         {
            st->twiddles = base->twiddles;
+           st->twiddles_cos = base->twiddles_cos;
+           st->twiddles_sin = base->twiddles_sin;
            st->shift = 0;
            while (st->shift < 32 && nfft<<st->shift != base->nfft)
               st->shift++;
            if (st->shift>=32)
               goto fail;
         } else {
+           float *tw_cos;
+           float *tw_sin;
+           int i;
+           st->shift = -1;
            st->twiddles = twiddles = (kiss_twiddle_cpx*)opus_alloc(sizeof(kiss_twiddle_cpx)*nfft);
            compute_twiddles(twiddles, nfft);
-           st->shift = -1;
+           st->twiddles_cos = tw_cos = (float*)opus_alloc(sizeof(float)*nfft);
+           st->twiddles_sin = tw_sin = (float*)opus_alloc(sizeof(float)*nfft);
+           if (tw_cos == 
+                        ((void *)0)
+                             || tw_sin == 
+                                         ((void *)0)
+                                              )
+              goto fail;
+           for (i=0;i<nfft;i++)
+           {
+              tw_cos[i] = twiddles[i].r;
+              tw_sin[i] = twiddles[i].i;
+           }
         }
         if (!kf_factor(nfft,st->factors))
         {
@@ -3464,7 +4549,11 @@ void opus_fft_free(const kiss_fft_state *cfg, int arch)
       ((void)(arch), opus_fft_free_arch_c((kiss_fft_state *)cfg));
       opus_free((opus_int16*)cfg->bitrev);
       if (cfg->shift < 0)
+      {
          opus_free((kiss_twiddle_cpx*)cfg->twiddles);
+         opus_free((float*)cfg->twiddles_cos);
+         opus_free((float*)cfg->twiddles_sin);
+      }
       opus_free((kiss_fft_state*)cfg);
    }
 }
@@ -3492,7 +4581,23 @@ void opus_fft_impl(const kiss_fft_state *st,kiss_fft_cpx *fout)
        L++;
     } while(m!=1);
     m = st->factors[2*L-1];
-    for (i=L-1;i>=0;i--)
+    i = L-1;
+    /*
+    kf_factor splits an odd power of two into a trailing 4,2 pair, so the
+    480- and 120-point schedules always end radix-4 (m==1) then radix-2
+    (m==4). Run those two stages fused so each group of eight stays in
+    registers between them; kf_bfly8 is bit-identical to the pair it
+    replaces.
+    */
+    if (L>=2 && m==1 && st->factors[2*(L-1)]==4
+     && st->factors[2*(L-2)]==2 && st->factors[2*(L-2)+1]==4)
+    {
+       kf_bfly8(fout, fstride[L-2]);
+       i = L-3;
+       if (i>=0)
+          m = st->factors[2*i+1];
+    }
+    for (;i>=0;i--)
     {
        if (i!=0)
           m2 = st->factors[2*i-1];
@@ -3547,10 +4652,14 @@ void opus_ifft_c(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *
    int i;
    ;
 
+   /* Conjugate during the bitrev copy instead of in a second pass; float
+      negation is exact so this changes nothing in the output. */
    for (i=0;i<st->nfft;i++)
-      fout[st->bitrev[i]] = fin[i];
-   for (i=0;i<st->nfft;i++)
-      fout[i].i = -fout[i].i;
+   {
+      kiss_fft_cpx x = fin[i];
+      x.i = -x.i;
+      fout[st->bitrev[i]] = x;
+   }
    opus_fft_impl(st, fout);
    for (i=0;i<st->nfft;i++)
       fout[i].i = -fout[i].i;
@@ -3778,9 +4887,80 @@ void clt_mdct_backward_c(const mdct_lookup *l, float *in, float * restrict out,
       float * yp0 = out+(overlap>>1);
       float * yp1 = out+(overlap>>1)+N2-2;
       const float *t = &trig[0];
-
-
-      for(i=0;i<(N4+1)>>1;i++)
+      int count = (N4+1)>>1;
+
+      i=0;
+      /*
+      Four mirror iterations at a time. Each lane applies the same two
+      multiplies and one add/sub as the scalar body, so the results are
+      identical; all loads in a block precede its stores, which matches the
+      scalar ordering because a store at mirror position i and a load at
+      position j only touch the same word when i+j==N4-1, and the half-length
+      loop keeps i+j at most N4-3.
+      */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      for(;i+4<=count;i+=4)
+      {
+         __m128 A  = _mm_loadu_ps(yp0);
+         __m128 B  = _mm_loadu_ps(yp0+4);
+         __m128 Cl = _mm_loadu_ps(yp1-6);
+         __m128 Ch = _mm_loadu_ps(yp1-2);
+         __m128 re_f = _mm_shuffle_ps(A,B,_MM_SHUFFLE(3,1,3,1));
+         __m128 im_f = _mm_shuffle_ps(A,B,_MM_SHUFFLE(2,0,2,0));
+         __m128 re_b = _mm_shuffle_ps(Ch,Cl,_MM_SHUFFLE(1,3,1,3));
+         __m128 im_b = _mm_shuffle_ps(Ch,Cl,_MM_SHUFFLE(0,2,0,2));
+         __m128 t0_f = _mm_loadu_ps(t+i);
+         __m128 t1_f = _mm_loadu_ps(t+N4+i);
+         __m128 t0_b = _mm_loadu_ps(t+N4-i-4);
+         __m128 t1_b = _mm_loadu_ps(t+N2-i-4);
+         __m128 yr_f, yi_f, yr_b, yi_b, rev_r, rev_i;
+         t0_b = _mm_shuffle_ps(t0_b,t0_b,_MM_SHUFFLE(0,1,2,3));
+         t1_b = _mm_shuffle_ps(t1_b,t1_b,_MM_SHUFFLE(0,1,2,3));
+         yr_f = _mm_add_ps(_mm_mul_ps(re_f,t0_f),_mm_mul_ps(im_f,t1_f));
+         yi_f = _mm_sub_ps(_mm_mul_ps(re_f,t1_f),_mm_mul_ps(im_f,t0_f));
+         yr_b = _mm_add_ps(_mm_mul_ps(re_b,t0_b),_mm_mul_ps(im_b,t1_b));
+         yi_b = _mm_sub_ps(_mm_mul_ps(re_b,t1_b),_mm_mul_ps(im_b,t0_b));
+         _mm_storeu_ps(yp0,  _mm_unpacklo_ps(yr_f,yi_b));
+         _mm_storeu_ps(yp0+4,_mm_unpackhi_ps(yr_f,yi_b));
+         rev_r = _mm_shuffle_ps(yr_b,yr_b,_MM_SHUFFLE(0,1,2,3));
+         rev_i = _mm_shuffle_ps(yi_f,yi_f,_MM_SHUFFLE(0,1,2,3));
+         _mm_storeu_ps(yp1-6,_mm_unpacklo_ps(rev_r,rev_i));
+         _mm_storeu_ps(yp1-2,_mm_unpackhi_ps(rev_r,rev_i));
+         yp0 += 8;
+         yp1 -= 8;
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for(;i+4<=count;i+=4)
+      {
+         float32x4x2_t F = vld2q_f32(yp0);
+         float32x4x2_t Bk = vld2q_f32(yp1-6);
+         float32x4_t im_f = F.val[0];
+         float32x4_t re_f = F.val[1];
+         float32x4_t im_b = vrev64q_f32(vcombine_f32(vget_high_f32(Bk.val[0]),vget_low_f32(Bk.val[0])));
+         float32x4_t re_b = vrev64q_f32(vcombine_f32(vget_high_f32(Bk.val[1]),vget_low_f32(Bk.val[1])));
+         float32x4_t t0_f = vld1q_f32(t+i);
+         float32x4_t t1_f = vld1q_f32(t+N4+i);
+         float32x4_t t0_b = vld1q_f32(t+N4-i-4);
+         float32x4_t t1_b = vld1q_f32(t+N2-i-4);
+         float32x4_t yr_f, yi_f, yr_b, yi_b;
+         float32x4x2_t So, Sm;
+         t0_b = vrev64q_f32(vcombine_f32(vget_high_f32(t0_b),vget_low_f32(t0_b)));
+         t1_b = vrev64q_f32(vcombine_f32(vget_high_f32(t1_b),vget_low_f32(t1_b)));
+         yr_f = vaddq_f32(vmulq_f32(re_f,t0_f),vmulq_f32(im_f,t1_f));
+         yi_f = vsubq_f32(vmulq_f32(re_f,t1_f),vmulq_f32(im_f,t0_f));
+         yr_b = vaddq_f32(vmulq_f32(re_b,t0_b),vmulq_f32(im_b,t1_b));
+         yi_b = vsubq_f32(vmulq_f32(re_b,t1_b),vmulq_f32(im_b,t0_b));
+         So.val[0] = yr_f;
+         So.val[1] = yi_b;
+         vst2q_f32(yp0,So);
+         Sm.val[0] = vrev64q_f32(vcombine_f32(vget_high_f32(yr_b),vget_low_f32(yr_b)));
+         Sm.val[1] = vrev64q_f32(vcombine_f32(vget_high_f32(yi_f),vget_low_f32(yi_f)));
+         vst2q_f32(yp1-6,Sm);
+         yp0 += 8;
+         yp1 -= 8;
+      }
+#endif
+      for(;i<count;i++)
       {
          float re, im, yr, yi;
          float t0, t1;
@@ -3816,8 +4996,56 @@ void clt_mdct_backward_c(const mdct_lookup *l, float *in, float * restrict out,
       float * restrict yp1 = out;
       const opus_val16 * restrict wp1 = window;
       const opus_val16 * restrict wp2 = window+overlap-1;
-
-      for(i = 0; i < overlap/2; i++)
+      int half = overlap/2;
+
+      i = 0;
+      /*
+      The two streams walk inward from opposite ends and never cross, so
+      four lanes can run the exact scalar arithmetic with the descending
+      side loaded and stored through a reversal shuffle.
+      */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      for(;i+4<=half;i+=4)
+      {
+         __m128 x2 = _mm_loadu_ps(yp1);
+         __m128 x1 = _mm_loadu_ps(xp1-3);
+         __m128 w1 = _mm_loadu_ps(wp1);
+         __m128 w2 = _mm_loadu_ps(wp2-3);
+         __m128 lo, hi;
+         x1 = _mm_shuffle_ps(x1,x1,_MM_SHUFFLE(0,1,2,3));
+         w2 = _mm_shuffle_ps(w2,w2,_MM_SHUFFLE(0,1,2,3));
+         lo = _mm_sub_ps(_mm_mul_ps(w2,x2),_mm_mul_ps(w1,x1));
+         hi = _mm_add_ps(_mm_mul_ps(w1,x2),_mm_mul_ps(w2,x1));
+         _mm_storeu_ps(yp1,lo);
+         hi = _mm_shuffle_ps(hi,hi,_MM_SHUFFLE(0,1,2,3));
+         _mm_storeu_ps(xp1-3,hi);
+         yp1 += 4;
+         xp1 -= 4;
+         wp1 += 4;
+         wp2 -= 4;
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for(;i+4<=half;i+=4)
+      {
+         float32x4_t x2 = vld1q_f32(yp1);
+         float32x4_t x1 = vld1q_f32(xp1-3);
+         float32x4_t w1 = vld1q_f32(wp1);
+         float32x4_t w2 = vld1q_f32(wp2-3);
+         float32x4_t lo, hi;
+         x1 = vrev64q_f32(vcombine_f32(vget_high_f32(x1),vget_low_f32(x1)));
+         w2 = vrev64q_f32(vcombine_f32(vget_high_f32(w2),vget_low_f32(w2)));
+         lo = vsubq_f32(vmulq_f32(w2,x2),vmulq_f32(w1,x1));
+         hi = vaddq_f32(vmulq_f32(w1,x2),vmulq_f32(w2,x1));
+         vst1q_f32(yp1,lo);
+         hi = vrev64q_f32(vcombine_f32(vget_high_f32(hi),vget_low_f32(hi)));
+         vst1q_f32(xp1-3,hi);
+         yp1 += 4;
+         xp1 -= 4;
+         wp1 += 4;
+         wp2 -= 4;
+      }
+#endif
+      for(;i < half;i++)
       {
          float x1, x2;
          x1 = *xp1;
@@ -3873,6 +5101,44 @@ static inline void xcorr_kernel_c(const opus_val16 * x, const opus_val16 * y, op
    int j;
    opus_val16 y_0, y_1, y_2, y_3;
    ;
+   /*
+   Lane k of the vector accumulator carries sum[k], and each step adds
+   x[j]*y[j+k] to all four lanes in the same serial order as the rotating
+   scalar code below, so the result is bit-identical. The y loads reach
+   y[len+2] at most, which the callers already guarantee (the scalar code
+   consumes the same range).
+   */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      __m128 xsum = _mm_loadu_ps(sum);
+      for (j=0;j<len-3;j+=4)
+      {
+         xsum = _mm_add_ps(xsum, _mm_mul_ps(_mm_set1_ps(x[j]),   _mm_loadu_ps(y+j)));
+         xsum = _mm_add_ps(xsum, _mm_mul_ps(_mm_set1_ps(x[j+1]), _mm_loadu_ps(y+j+1)));
+         xsum = _mm_add_ps(xsum, _mm_mul_ps(_mm_set1_ps(x[j+2]), _mm_loadu_ps(y+j+2)));
+         xsum = _mm_add_ps(xsum, _mm_mul_ps(_mm_set1_ps(x[j+3]), _mm_loadu_ps(y+j+3)));
+      }
+      for (;j<len;j++)
+         xsum = _mm_add_ps(xsum, _mm_mul_ps(_mm_set1_ps(x[j]), _mm_loadu_ps(y+j)));
+      _mm_storeu_ps(sum, xsum);
+      return;
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   {
+      float32x4_t xsum = vld1q_f32(sum);
+      for (j=0;j<len-3;j+=4)
+      {
+         xsum = vaddq_f32(xsum, vmulq_n_f32(vld1q_f32(y+j),   x[j]));
+         xsum = vaddq_f32(xsum, vmulq_n_f32(vld1q_f32(y+j+1), x[j+1]));
+         xsum = vaddq_f32(xsum, vmulq_n_f32(vld1q_f32(y+j+2), x[j+2]));
+         xsum = vaddq_f32(xsum, vmulq_n_f32(vld1q_f32(y+j+3), x[j+3]));
+      }
+      for (;j<len;j++)
+         xsum = vaddq_f32(xsum, vmulq_n_f32(vld1q_f32(y+j), x[j]));
+      vst1q_f32(sum, xsum);
+      return;
+   }
+#endif
    y_3=0;
    y_0=*y++;
    y_1=*y++;
@@ -3999,7 +5265,47 @@ int p
          r = -((float)((rr))/(error));
 
          lpc[i] = (r);
-         for (j = 0; j < (i+1)>>1; j++)
+         j = 0;
+         /*
+         The reflection update pairs lpc[j] with lpc[i-1-j], and the pairs
+         partition the array, so four pairs can be updated at once: load both
+         ends, reverse the upper block, apply the scalar tmp1 + r*tmp2 /
+         tmp2 + r*tmp1 expressions per lane, and store low before high. For
+         odd i the two blocks can meet at the self-paired middle element;
+         storing the high block last leaves it with tmp2 + r*tmp1, exactly as
+         the scalar write order does.
+         */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         {
+            const __m128 vr = _mm_set1_ps(r);
+            for (; j+4 <= (i+1)>>1; j+=4)
+            {
+               __m128 lo = _mm_loadu_ps(lpc+j);
+               __m128 hi = _mm_loadu_ps(lpc+i-4-j);
+               __m128 hi_rev = _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(0,1,2,3));
+               __m128 lo_new = _mm_add_ps(lo, _mm_mul_ps(vr, hi_rev));
+               __m128 hi_new = _mm_add_ps(hi_rev, _mm_mul_ps(vr, lo));
+               _mm_storeu_ps(lpc+j, lo_new);
+               hi_new = _mm_shuffle_ps(hi_new, hi_new, _MM_SHUFFLE(0,1,2,3));
+               _mm_storeu_ps(lpc+i-4-j, hi_new);
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         {
+            for (; j+4 <= (i+1)>>1; j+=4)
+            {
+               float32x4_t lo = vld1q_f32(lpc+j);
+               float32x4_t hi = vld1q_f32(lpc+i-4-j);
+               float32x4_t hi_rev = vrev64q_f32(vcombine_f32(vget_high_f32(hi), vget_low_f32(hi)));
+               float32x4_t lo_new = vaddq_f32(lo, vmulq_n_f32(hi_rev, r));
+               float32x4_t hi_new = vaddq_f32(hi_rev, vmulq_n_f32(lo, r));
+               vst1q_f32(lpc+j, lo_new);
+               hi_new = vrev64q_f32(vcombine_f32(vget_high_f32(hi_new), vget_low_f32(hi_new)));
+               vst1q_f32(lpc+i-4-j, hi_new);
+            }
+         }
+#endif
+         for (; j < (i+1)>>1; j++)
          {
             opus_val32 tmp1, tmp2;
             tmp1 = lpc[j];
@@ -4147,12 +5453,53 @@ int _celt_autocorr(
    {
       xptr = x;
    } else {
-      for (i=0;i<n;i++)
-         xx[i] = x[i];
-      for (i=0;i<overlap;i++)
+      if (2*overlap <= n)
       {
-         xx[i] = ((x[i])*(window[i]));
-         xx[n-i-1] = ((x[n-i-1])*(window[i]));
+         /*
+         One pass instead of copy-then-window: the two windowed segments are
+         written directly and the middle is a straight copy. The windowed
+         stores are plain per-element multiplies, so the vector forms are
+         bit-identical to the scalar ones.
+         */
+         i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         for (;i+4<=overlap;i+=4)
+            _mm_storeu_ps(xx+i, _mm_mul_ps(_mm_loadu_ps(x+i), _mm_loadu_ps(window+i)));
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         for (;i+4<=overlap;i+=4)
+            vst1q_f32(xx+i, vmulq_f32(vld1q_f32(x+i), vld1q_f32(window+i)));
+#endif
+         for (;i<overlap;i++)
+            xx[i] = ((x[i])*(window[i]));
+         (memcpy((xx+overlap), (x+overlap), (n-2*overlap)*sizeof(*xx)));
+         i = n-overlap;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         for (;i+4<=n;i+=4)
+         {
+            __m128 w = _mm_loadu_ps(window+n-4-i);
+            w = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0,1,2,3));
+            _mm_storeu_ps(xx+i, _mm_mul_ps(_mm_loadu_ps(x+i), w));
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         for (;i+4<=n;i+=4)
+         {
+            float32x4_t w = vld1q_f32(window+n-4-i);
+            w = vrev64q_f32(vcombine_f32(vget_high_f32(w), vget_low_f32(w)));
+            vst1q_f32(xx+i, vmulq_f32(vld1q_f32(x+i), w));
+         }
+#endif
+         for (;i<n;i++)
+            xx[i] = ((x[i])*(window[n-1-i]));
+      } else {
+         /* Overlapping windows: keep the original write order, whose
+            last-write-wins behaviour in the middle is part of the output. */
+         for (i=0;i<n;i++)
+            xx[i] = x[i];
+         for (i=0;i<overlap;i++)
+         {
+            xx[i] = ((x[i])*(window[i]));
+            xx[n-i-1] = ((x[n-i-1])*(window[i]));
+         }
       }
       xptr = xx;
    }
@@ -4244,7 +5591,68 @@ static void celt_fir5(opus_val16 *x,
    mem2=0;
    mem3=0;
    mem4=0;
-   for (i=0;i<N;i++)
+   i=0;
+   /*
+   The filter is in place, so the vector path keeps the last nine original
+   input values in a small window: w[0..4] are the five samples the scalar
+   mem registers would hold, w[5..8] the current block, refreshed before the
+   block's outputs overwrite them. Each lane then evaluates the scalar
+   add/mul chain on the same operands in the same order, so the output is
+   bit-identical.
+   */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      float w[9];
+      const __m128 n0 = _mm_set1_ps(num0);
+      const __m128 n1 = _mm_set1_ps(num1);
+      const __m128 n2 = _mm_set1_ps(num2);
+      const __m128 n3 = _mm_set1_ps(num3);
+      const __m128 n4 = _mm_set1_ps(num4);
+      w[0]=w[1]=w[2]=w[3]=w[4]=0;
+      for (;i+4<=N;i+=4)
+      {
+         __m128 X = _mm_loadu_ps(x+i);
+         __m128 sum;
+         _mm_storeu_ps(w+5, X);
+         sum = _mm_add_ps(X, _mm_mul_ps(n0, _mm_loadu_ps(w+4)));
+         sum = _mm_add_ps(sum, _mm_mul_ps(n1, _mm_loadu_ps(w+3)));
+         sum = _mm_add_ps(sum, _mm_mul_ps(n2, _mm_loadu_ps(w+2)));
+         sum = _mm_add_ps(sum, _mm_mul_ps(n3, _mm_loadu_ps(w+1)));
+         sum = _mm_add_ps(sum, _mm_mul_ps(n4, _mm_loadu_ps(w+0)));
+         _mm_storeu_ps(x+i, sum);
+         w[0]=w[4]; w[1]=w[5]; w[2]=w[6]; w[3]=w[7]; w[4]=w[8];
+      }
+      mem0=w[4];
+      mem1=w[3];
+      mem2=w[2];
+      mem3=w[1];
+      mem4=w[0];
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   {
+      float w[9];
+      w[0]=w[1]=w[2]=w[3]=w[4]=0;
+      for (;i+4<=N;i+=4)
+      {
+         float32x4_t X = vld1q_f32(x+i);
+         float32x4_t sum;
+         vst1q_f32(w+5, X);
+         sum = vaddq_f32(X, vmulq_n_f32(vld1q_f32(w+4), num0));
+         sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(w+3), num1));
+         sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(w+2), num2));
+         sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(w+1), num3));
+         sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(w+0), num4));
+         vst1q_f32(x+i, sum);
+         w[0]=w[4]; w[1]=w[5]; w[2]=w[6]; w[3]=w[7]; w[4]=w[8];
+      }
+      mem0=w[4];
+      mem1=w[3];
+      mem2=w[2];
+      mem3=w[1];
+      mem4=w[0];
+   }
+#endif
+   for (;i<N;i++)
    {
       opus_val32 sum = ((x[i]));
       sum = ((sum)+(opus_val32)(num0)*(opus_val32)(mem0));
@@ -4271,12 +5679,85 @@ void pitch_downsample(celt_sig * restrict x[], opus_val16 * restrict x_lp,
    opus_val16 lpc[4];
    opus_val16 lpc2[5];
    opus_val16 c1 = (.8f);
-   for (i=1;i<len>>1;i++)
+   i=1;
+   /*
+   The decimator is fully data-parallel, so the vector paths produce four
+   outputs per iteration. Each lane computes .25*x[2i-1] + .25*x[2i+1]
+   + .5*x[2i] with the scalar's operand order, so results are bit-exact.
+   The odd-tap gathers are arranged so no load reads past x[2i+7], which
+   the last scalar iteration would touch anyway.
+   */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      const __m128 q = _mm_set1_ps(.25f);
+      const __m128 h = _mm_set1_ps(.5f);
+      for (;i+4<=len>>1;i+=4)
+      {
+         const float *p = x[0]+2*i;
+         __m128 L0 = _mm_loadu_ps(p-1);
+         __m128 L1 = _mm_loadu_ps(p+3);
+         __m128 E0 = _mm_loadu_ps(p);
+         __m128 E1 = _mm_loadu_ps(p+4);
+         __m128 odd_lo = _mm_shuffle_ps(L0, L1, _MM_SHUFFLE(2,0,2,0));
+         __m128 even   = _mm_shuffle_ps(E0, E1, _MM_SHUFFLE(2,0,2,0));
+         __m128 odd_hi = _mm_setr_ps(p[1], p[3], p[5], p[7]);
+         __m128 sum = _mm_add_ps(_mm_mul_ps(q, odd_lo), _mm_mul_ps(q, odd_hi));
+         _mm_storeu_ps(x_lp+i, _mm_add_ps(sum, _mm_mul_ps(h, even)));
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   {
+      for (;i+4<=len>>1;i+=4)
+      {
+         const float *p = x[0]+2*i;
+         float32x4x2_t d = vld2q_f32(p-1);
+         float32x4_t odd_hi = vextq_f32(d.val[0], vld1q_dup_f32(p+7), 1);
+         float32x4_t sum = vaddq_f32(vmulq_n_f32(d.val[0], .25f),
+                                     vmulq_n_f32(odd_hi, .25f));
+         vst1q_f32(x_lp+i, vaddq_f32(sum, vmulq_n_f32(d.val[1], .5f)));
+      }
+   }
+#endif
+   for (;i<len>>1;i++)
       x_lp[i] = .25f*x[0][(2*i-1)] + .25f*x[0][(2*i+1)] + .5f*x[0][2*i];
    x_lp[0] = .25f*x[0][1] + .5f*x[0][0];
    if (C==2)
    {
-      for (i=1;i<len>>1;i++)
+      i=1;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      {
+         const __m128 q = _mm_set1_ps(.25f);
+         const __m128 h = _mm_set1_ps(.5f);
+         for (;i+4<=len>>1;i+=4)
+         {
+            const float *p = x[1]+2*i;
+            __m128 L0 = _mm_loadu_ps(p-1);
+            __m128 L1 = _mm_loadu_ps(p+3);
+            __m128 E0 = _mm_loadu_ps(p);
+            __m128 E1 = _mm_loadu_ps(p+4);
+            __m128 odd_lo = _mm_shuffle_ps(L0, L1, _MM_SHUFFLE(2,0,2,0));
+            __m128 even   = _mm_shuffle_ps(E0, E1, _MM_SHUFFLE(2,0,2,0));
+            __m128 odd_hi = _mm_setr_ps(p[1], p[3], p[5], p[7]);
+            __m128 sum = _mm_add_ps(_mm_mul_ps(q, odd_lo), _mm_mul_ps(q, odd_hi));
+            sum = _mm_add_ps(sum, _mm_mul_ps(h, even));
+            _mm_storeu_ps(x_lp+i, _mm_add_ps(_mm_loadu_ps(x_lp+i), sum));
+         }
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      {
+         for (;i+4<=len>>1;i+=4)
+         {
+            const float *p = x[1]+2*i;
+            float32x4x2_t d = vld2q_f32(p-1);
+            float32x4_t odd_hi = vextq_f32(d.val[0], vld1q_dup_f32(p+7), 1);
+            float32x4_t sum = vaddq_f32(vmulq_n_f32(d.val[0], .25f),
+                                        vmulq_n_f32(odd_hi, .25f));
+            sum = vaddq_f32(sum, vmulq_n_f32(d.val[1], .5f));
+            vst1q_f32(x_lp+i, vaddq_f32(vld1q_f32(x_lp+i), sum));
+         }
+      }
+#endif
+      for (;i<len>>1;i++)
          x_lp[i] += .25f*x[1][(2*i-1)] + .25f*x[1][(2*i+1)] + .5f*x[1][2*i];
       x_lp[0] += .25f*x[1][1] + .5f*x[1][0];
    }
@@ -4985,7 +6466,22 @@ void renormalise_vector(celt_norm *X, int N, opus_val16 gain, int arch)
    g = ((((1.f/((float)sqrt(t)))))*(gain));
 
    xptr = X;
-   for (i=0;i<N;i++)
+   i = 0;
+   /* The scaling pass is a single independent multiply per sample, so the
+      broadcast vector forms produce the same bits as the scalar loop. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      const __m128 vg = _mm_set1_ps(g);
+      for (;i+4<=N;i+=4)
+         _mm_storeu_ps(X+i, _mm_mul_ps(vg, _mm_loadu_ps(X+i)));
+      xptr = X+i;
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   for (;i+4<=N;i+=4)
+      vst1q_f32(X+i, vmulq_n_f32(vld1q_f32(X+i), g));
+   xptr = X+i;
+#endif
+   for (;i<N;i++)
    {
       *xptr = ((((opus_val32)(g)*(opus_val32)(*xptr))));
       xptr++;
@@ -5147,9 +6643,30 @@ void denormalise_bands(const OpusCustomMode *m, const celt_norm * restrict X,
       lg = (((bandLogE[i])+(((opus_val32)eMeans[i]))));
 
       g = ((float)exp(0.6931471805599453094*(((32.f) < (lg) ? (32.f) : (lg)))));
-         do {
+      /* Per-sample scaling by the band gain; the broadcast vector forms
+         match the scalar multiply bit for bit. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      {
+         const __m128 vg = _mm_set1_ps(g);
+         for (;j+4<=band_end;j+=4)
+         {
+            _mm_storeu_ps(f, _mm_mul_ps(vg, _mm_loadu_ps(x)));
+            f += 4;
+            x += 4;
+         }
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for (;j+4<=band_end;j+=4)
+      {
+         vst1q_f32(f, vmulq_n_f32(vld1q_f32(x), g));
+         f += 4;
+         x += 4;
+      }
+#endif
+         while (j<band_end) {
             *f++ = (((opus_val32)(*x++)*(opus_val32)(g)));
-         } while (++j<band_end);
+            j++;
+         }
    }
    ;
    (memset((&freq[bound]), 0, (N-bound)*sizeof(*(&freq[bound]))));
@@ -5278,7 +6795,7 @@ static void stereo_split(celt_norm * restrict X, celt_norm * restrict Y, int N)
    }
 }
 
-static void stereo_merge(celt_norm * restrict X, celt_norm * restrict Y, opus_val16 mid, int N, int arch)
+static void stereo_merge(celt_norm * restrict X, celt_norm * restrict Y, opus_val16 mid, int N, int inv, int arch)
 {
    int j;
    opus_val32 xp=0, side=0;
@@ -5299,7 +6816,13 @@ static void stereo_merge(celt_norm * restrict X, celt_norm * restrict Y, opus_va
    Er = ((opus_val32)(mid2)*(opus_val32)(mid2)) + side + 2*xp;
    if (Er < (6e-4f) || El < (6e-4f))
    {
-      (memcpy((Y), (X), (N)*sizeof(*(Y)) + 0*((Y)-(X)) ));
+      if (inv)
+      {
+         for (j=0;j<N;j++)
+            Y[j] = -X[j];
+      } else {
+         (memcpy((Y), (X), (N)*sizeof(*(Y)) + 0*((Y)-(X)) ));
+      }
       return;
    }
 
@@ -5311,7 +6834,36 @@ static void stereo_merge(celt_norm * restrict X, celt_norm * restrict Y, opus_va
    lgain = ((1.f/((float)sqrt(t))));
    t = (Er);
    rgain = ((1.f/((float)sqrt(t))));
-   for (j=0;j<N;j++)
+   /* Folding the inverted-stereo negation into the right gain saves a
+      second sweep over Y; (-g)*x produces the same bits as -(g*x). */
+   if (inv)
+      rgain = -rgain;
+   j = 0;
+   /* Each sample is an independent mid*X[j] +/- Y[j] scaled by the two
+      gains, so the broadcast vector forms match the scalar bits exactly. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      const __m128 vmid = _mm_set1_ps(mid);
+      const __m128 vlg = _mm_set1_ps(lgain);
+      const __m128 vrg = _mm_set1_ps(rgain);
+      for (;j+4<=N;j+=4)
+      {
+         __m128 l = _mm_mul_ps(vmid, _mm_loadu_ps(X+j));
+         __m128 r = _mm_loadu_ps(Y+j);
+         _mm_storeu_ps(X+j, _mm_mul_ps(vlg, _mm_sub_ps(l, r)));
+         _mm_storeu_ps(Y+j, _mm_mul_ps(vrg, _mm_add_ps(l, r)));
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   for (;j+4<=N;j+=4)
+   {
+      float32x4_t l = vmulq_n_f32(vld1q_f32(X+j), mid);
+      float32x4_t r = vld1q_f32(Y+j);
+      vst1q_f32(X+j, vmulq_n_f32(vsubq_f32(l, r), lgain));
+      vst1q_f32(Y+j, vmulq_n_f32(vaddq_f32(l, r), rgain));
+   }
+#endif
+   for (;j<N;j++)
    {
       celt_norm r, l;
 
@@ -5427,6 +6979,38 @@ static const int ordery_table[] = {
       15, 0, 8, 7, 12, 3, 11, 4, 14, 1, 9, 6, 13, 2, 10, 5,
 };
 
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+/* 4x4 transpose step shared by the hadamard reshuffles: vector m of the
+   result holds (s0[m],s1[m],s2[m],s3[m]). Pure data movement. */
+static DR_OPUS_INLINE void celt_transpose4(const celt_norm *s0, const celt_norm *s1,
+      const celt_norm *s2, const celt_norm *s3,
+      celt_norm *d0, celt_norm *d1, celt_norm *d2, celt_norm *d3)
+{
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   __m128 v0 = _mm_loadu_ps(s0);
+   __m128 v1 = _mm_loadu_ps(s1);
+   __m128 v2 = _mm_loadu_ps(s2);
+   __m128 v3 = _mm_loadu_ps(s3);
+   _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+   _mm_storeu_ps(d0, v0);
+   _mm_storeu_ps(d1, v1);
+   _mm_storeu_ps(d2, v2);
+   _mm_storeu_ps(d3, v3);
+#else
+   float32x4_t v0 = vld1q_f32(s0);
+   float32x4_t v1 = vld1q_f32(s1);
+   float32x4_t v2 = vld1q_f32(s2);
+   float32x4_t v3 = vld1q_f32(s3);
+   float32x4x2_t t01 = vtrnq_f32(v0, v1);
+   float32x4x2_t t23 = vtrnq_f32(v2, v3);
+   vst1q_f32(d0, vcombine_f32(vget_low_f32(t01.val[0]),  vget_low_f32(t23.val[0])));
+   vst1q_f32(d1, vcombine_f32(vget_low_f32(t01.val[1]),  vget_low_f32(t23.val[1])));
+   vst1q_f32(d2, vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+   vst1q_f32(d3, vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#endif
+}
+#endif
+
 static void deinterleave_hadamard(celt_norm *X, int N0, int stride, int hadamard)
 {
    int i,j;
@@ -5439,12 +7023,57 @@ static void deinterleave_hadamard(celt_norm *X, int N0, int stride, int hadamard
    if (hadamard)
    {
       const int *ordery = ordery_table+stride-2;
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+      /* stride is a power of two; for stride>=4 run the reshuffle as 4x4
+         transposed blocks with the row permutation applied per block. */
+      if ((stride&3)==0)
+      {
+         for (i=0;i<stride;i+=4)
+         {
+            celt_norm *r0 = tmp+ordery[i]*N0;
+            celt_norm *r1 = tmp+ordery[i+1]*N0;
+            celt_norm *r2 = tmp+ordery[i+2]*N0;
+            celt_norm *r3 = tmp+ordery[i+3]*N0;
+            for (j=0;j+4<=N0;j+=4)
+               celt_transpose4(X+j*stride+i, X+(j+1)*stride+i,
+                               X+(j+2)*stride+i, X+(j+3)*stride+i,
+                               r0+j, r1+j, r2+j, r3+j);
+            for (;j<N0;j++)
+            {
+               r0[j] = X[j*stride+i];
+               r1[j] = X[j*stride+i+1];
+               r2[j] = X[j*stride+i+2];
+               r3[j] = X[j*stride+i+3];
+            }
+         }
+      } else
+#endif
       for (i=0;i<stride;i++)
       {
          for (j=0;j<N0;j++)
             tmp[ordery[i]*N0+j] = X[j*stride+i];
       }
    } else {
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+      if ((stride&3)==0)
+      {
+         for (i=0;i<stride;i+=4)
+         {
+            for (j=0;j+4<=N0;j+=4)
+               celt_transpose4(X+j*stride+i, X+(j+1)*stride+i,
+                               X+(j+2)*stride+i, X+(j+3)*stride+i,
+                               tmp+i*N0+j, tmp+(i+1)*N0+j,
+                               tmp+(i+2)*N0+j, tmp+(i+3)*N0+j);
+            for (;j<N0;j++)
+            {
+               tmp[i*N0+j] = X[j*stride+i];
+               tmp[(i+1)*N0+j] = X[j*stride+i+1];
+               tmp[(i+2)*N0+j] = X[j*stride+i+2];
+               tmp[(i+3)*N0+j] = X[j*stride+i+3];
+            }
+         }
+      } else
+#endif
       for (i=0;i<stride;i++)
          for (j=0;j<N0;j++)
             tmp[i*N0+j] = X[j*stride+i];
@@ -5464,10 +7093,53 @@ static void interleave_hadamard(celt_norm *X, int N0, int stride, int hadamard)
    if (hadamard)
    {
       const int *ordery = ordery_table+stride-2;
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+      if ((stride&3)==0)
+      {
+         for (i=0;i<stride;i+=4)
+         {
+            const celt_norm *s0 = X+ordery[i]*N0;
+            const celt_norm *s1 = X+ordery[i+1]*N0;
+            const celt_norm *s2 = X+ordery[i+2]*N0;
+            const celt_norm *s3 = X+ordery[i+3]*N0;
+            for (j=0;j+4<=N0;j+=4)
+               celt_transpose4(s0+j, s1+j, s2+j, s3+j,
+                               tmp+j*stride+i, tmp+(j+1)*stride+i,
+                               tmp+(j+2)*stride+i, tmp+(j+3)*stride+i);
+            for (;j<N0;j++)
+            {
+               tmp[j*stride+i] = s0[j];
+               tmp[j*stride+i+1] = s1[j];
+               tmp[j*stride+i+2] = s2[j];
+               tmp[j*stride+i+3] = s3[j];
+            }
+         }
+      } else
+#endif
       for (i=0;i<stride;i++)
          for (j=0;j<N0;j++)
             tmp[j*stride+i] = X[ordery[i]*N0+j];
    } else {
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+      if ((stride&3)==0)
+      {
+         for (i=0;i<stride;i+=4)
+         {
+            for (j=0;j+4<=N0;j+=4)
+               celt_transpose4(X+i*N0+j, X+(i+1)*N0+j,
+                               X+(i+2)*N0+j, X+(i+3)*N0+j,
+                               tmp+j*stride+i, tmp+(j+1)*stride+i,
+                               tmp+(j+2)*stride+i, tmp+(j+3)*stride+i);
+            for (;j<N0;j++)
+            {
+               tmp[j*stride+i] = X[i*N0+j];
+               tmp[j*stride+i+1] = X[(i+1)*N0+j];
+               tmp[j*stride+i+2] = X[(i+2)*N0+j];
+               tmp[j*stride+i+3] = X[(i+3)*N0+j];
+            }
+         }
+      } else
+#endif
       for (i=0;i<stride;i++)
          for (j=0;j<N0;j++)
             tmp[j*stride+i] = X[i*N0+j];
@@ -5480,6 +7152,108 @@ void haar1(celt_norm *X, int N0, int stride)
 {
    int i, j;
    N0 >>= 1;
+   /*
+   Every element belongs to exactly one (tmp1,tmp2) butterfly, so the pairs
+   can be processed in any order and in vector lanes; each lane performs the
+   same two scaled multiplies and add/sub as the scalar body, keeping the
+   output bit-identical. stride==1 is the interleaved case and gets a
+   structured load/store; larger strides run four columns at a time.
+   */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   if (stride == 1)
+   {
+      const __m128 c = _mm_set1_ps(.70710678f);
+      j = 0;
+      for (;j+4<=N0;j+=4)
+      {
+         __m128 v0 = _mm_loadu_ps(X+2*j);
+         __m128 v1 = _mm_loadu_ps(X+2*j+4);
+         __m128 a = _mm_mul_ps(c, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0)));
+         __m128 b = _mm_mul_ps(c, _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1)));
+         __m128 s = _mm_add_ps(a, b);
+         __m128 d = _mm_sub_ps(a, b);
+         _mm_storeu_ps(X+2*j,   _mm_unpacklo_ps(s, d));
+         _mm_storeu_ps(X+2*j+4, _mm_unpackhi_ps(s, d));
+      }
+      for (;j<N0;j++)
+      {
+         opus_val32 tmp1, tmp2;
+         tmp1 = ((opus_val32)((.70710678f))*(opus_val32)(X[2*j]));
+         tmp2 = ((opus_val32)((.70710678f))*(opus_val32)(X[2*j+1]));
+         X[2*j] = ((((tmp1)+(tmp2))));
+         X[2*j+1] = ((((tmp1)-(tmp2))));
+      }
+      return;
+   }
+   if (stride >= 4)
+   {
+      const __m128 c = _mm_set1_ps(.70710678f);
+      for (j=0;j<N0;j++)
+      {
+         for (i=0;i+4<=stride;i+=4)
+         {
+            __m128 a = _mm_mul_ps(c, _mm_loadu_ps(X+stride*2*j+i));
+            __m128 b = _mm_mul_ps(c, _mm_loadu_ps(X+stride*(2*j+1)+i));
+            _mm_storeu_ps(X+stride*2*j+i,     _mm_add_ps(a, b));
+            _mm_storeu_ps(X+stride*(2*j+1)+i, _mm_sub_ps(a, b));
+         }
+         for (;i<stride;i++)
+         {
+            opus_val32 tmp1, tmp2;
+            tmp1 = ((opus_val32)((.70710678f))*(opus_val32)(X[stride*2*j+i]));
+            tmp2 = ((opus_val32)((.70710678f))*(opus_val32)(X[stride*(2*j+1)+i]));
+            X[stride*2*j+i] = ((((tmp1)+(tmp2))));
+            X[stride*(2*j+1)+i] = ((((tmp1)-(tmp2))));
+         }
+      }
+      return;
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   if (stride == 1)
+   {
+      j = 0;
+      for (;j+4<=N0;j+=4)
+      {
+         float32x4x2_t p = vld2q_f32(X+2*j);
+         float32x4_t a = vmulq_n_f32(p.val[0], .70710678f);
+         float32x4_t b = vmulq_n_f32(p.val[1], .70710678f);
+         p.val[0] = vaddq_f32(a, b);
+         p.val[1] = vsubq_f32(a, b);
+         vst2q_f32(X+2*j, p);
+      }
+      for (;j<N0;j++)
+      {
+         opus_val32 tmp1, tmp2;
+         tmp1 = ((opus_val32)((.70710678f))*(opus_val32)(X[2*j]));
+         tmp2 = ((opus_val32)((.70710678f))*(opus_val32)(X[2*j+1]));
+         X[2*j] = ((((tmp1)+(tmp2))));
+         X[2*j+1] = ((((tmp1)-(tmp2))));
+      }
+      return;
+   }
+   if (stride >= 4)
+   {
+      for (j=0;j<N0;j++)
+      {
+         for (i=0;i+4<=stride;i+=4)
+         {
+            float32x4_t a = vmulq_n_f32(vld1q_f32(X+stride*2*j+i), .70710678f);
+            float32x4_t b = vmulq_n_f32(vld1q_f32(X+stride*(2*j+1)+i), .70710678f);
+            vst1q_f32(X+stride*2*j+i,     vaddq_f32(a, b));
+            vst1q_f32(X+stride*(2*j+1)+i, vsubq_f32(a, b));
+         }
+         for (;i<stride;i++)
+         {
+            opus_val32 tmp1, tmp2;
+            tmp1 = ((opus_val32)((.70710678f))*(opus_val32)(X[stride*2*j+i]));
+            tmp2 = ((opus_val32)((.70710678f))*(opus_val32)(X[stride*(2*j+1)+i]));
+            X[stride*2*j+i] = ((((tmp1)+(tmp2))));
+            X[stride*(2*j+1)+i] = ((((tmp1)-(tmp2))));
+         }
+      }
+      return;
+   }
+#endif
    for (i=0;i<stride;i++)
       for (j=0;j<N0;j++)
       {
@@ -5888,8 +7662,9 @@ static unsigned quant_partition(struct band_ctx *ctx, celt_norm *X,
       }
    } else {
 
-      q = bits2pulses(m, i, LM, b);
-      curr_bits = pulses2bits(m, i, LM, q);
+      const unsigned char *pcache = m->cache.bits + m->cache.index[(LM+1)*m->nbEBands+i];
+      q = bits2pulses_cache(pcache, b);
+      curr_bits = pulses2bits_cache(pcache, q);
       ctx->remaining_bits -= curr_bits;
 
 
@@ -5897,7 +7672,7 @@ static unsigned quant_partition(struct band_ctx *ctx, celt_norm *X,
       {
          ctx->remaining_bits += curr_bits;
          q--;
-         curr_bits = pulses2bits(m, i, LM, q);
+         curr_bits = pulses2bits_cache(pcache, q);
          ctx->remaining_bits -= curr_bits;
       }
 
@@ -6238,12 +8013,13 @@ static unsigned quant_band_stereo(struct band_ctx *ctx, celt_norm *X, celt_norm
    if (ctx->resynth)
    {
       if (N!=2)
-         stereo_merge(X, Y, mid, N, ctx->arch);
-      if (inv)
       {
-         int j;
-         for (j=0;j<N;j++)
-            Y[j] = -Y[j];
+         stereo_merge(X, Y, mid, N, inv, ctx->arch);
+      }
+      else if (inv)
+      {
+         Y[0] = -Y[0];
+         Y[1] = -Y[1];
       }
    }
    return cm;
@@ -6305,12 +8081,18 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
 
    M = 1<<LM;
    B = shortBlocks ? M : 1;
-   norm_offset = M*eBands[start];
+   /* The band boundaries in samples (Mband[i]) are used all over the
+      loop body; precompute them once so the body is plain loads instead of
+      multiplies the compiler cannot hoist across the quant_band calls. */
+   int *Mband = (int*)DR_OPUS_ALLOCA(sizeof(int)*(m->nbEBands+1));
+   for (i=0;i<=m->nbEBands;i++)
+      Mband[i] = M*eBands[i];
+   norm_offset = Mband[start];
 
 
-   celt_norm *_norm = (celt_norm*)DR_OPUS_ALLOCA(sizeof(celt_norm)*(C*(M*eBands[m->nbEBands-1]-norm_offset)));
+   celt_norm *_norm = (celt_norm*)DR_OPUS_ALLOCA(sizeof(celt_norm)*(C*(Mband[m->nbEBands-1]-norm_offset)));
    norm = _norm;
-   norm2 = norm + M*eBands[m->nbEBands-1]-norm_offset;
+   norm2 = norm + Mband[m->nbEBands-1]-norm_offset;
 
 
 
@@ -6323,7 +8105,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
    if (encode && resynth)
       lowband_scratch = _lowband_scratch;
    else
-      lowband_scratch = X_+M*eBands[m->nbEBands-1];
+      lowband_scratch = X_+Mband[m->nbEBands-1];
    celt_norm *X_save = (celt_norm*)DR_OPUS_ALLOCA(sizeof(celt_norm)*(resynth_alloc));
    celt_norm *Y_save = (celt_norm*)DR_OPUS_ALLOCA(sizeof(celt_norm)*(resynth_alloc));
    celt_norm *X_save2 = (celt_norm*)DR_OPUS_ALLOCA(sizeof(celt_norm)*(resynth_alloc));
@@ -6360,16 +8142,16 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
       ctx.i = i;
       last = (i==end-1);
 
-      X = X_+M*eBands[i];
+      X = X_+Mband[i];
       if (Y_!=
              ((void *)0)
                  )
-         Y = Y_+M*eBands[i];
+         Y = Y_+Mband[i];
       else
          Y = 
             ((void *)0)
                 ;
-      N = M*eBands[i+1]-M*eBands[i];
+      N = Mband[i+1]-Mband[i];
       ;
       tell = ec_tell_frac(ec);
 
@@ -6387,7 +8169,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
       }
 
 
-      if (resynth && (M*eBands[i]-N >= M*eBands[start] || i==start+1) && (update_lowband || lowband_offset==0))
+      if (resynth && (Mband[i]-N >= Mband[start] || i==start+1) && (update_lowband || lowband_offset==0))
             lowband_offset = i;
       if (i == start+1)
          special_hybrid_folding(m, norm, norm2, start, M, dual_stereo);
@@ -6422,12 +8204,12 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
          int fold_end;
          int fold_i;
 
-         effective_lowband = ((0) > (M*eBands[lowband_offset]-norm_offset-N) ? (0) : (M*eBands[lowband_offset]-norm_offset-N));
+         effective_lowband = ((0) > (Mband[lowband_offset]-norm_offset-N) ? (0) : (Mband[lowband_offset]-norm_offset-N));
          fold_start = lowband_offset;
-         while(M*eBands[--fold_start] > effective_lowband+norm_offset);
+         while(Mband[--fold_start] > effective_lowband+norm_offset);
          fold_end = lowband_offset-1;
 
-         while(++fold_end < i && M*eBands[fold_end] < effective_lowband+norm_offset+N);
+         while(++fold_end < i && Mband[fold_end] < effective_lowband+norm_offset+N);
 
 
 
@@ -6449,8 +8231,24 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
 
          dual_stereo = 0;
          if (resynth)
-            for (j=0;j<M*eBands[i]-norm_offset;j++)
+         {
+            int norm_len = Mband[i]-norm_offset;
+            j = 0;
+            /* Each element is an independent add and halving, so the vector
+               forms match the scalar loop bit for bit. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+            {
+               const __m128 vhalf = _mm_set1_ps(.5f);
+               for (;j+4<=norm_len;j+=4)
+                  _mm_storeu_ps(norm+j, _mm_mul_ps(vhalf, _mm_add_ps(_mm_loadu_ps(norm+j), _mm_loadu_ps(norm2+j))));
+            }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+            for (;j+4<=norm_len;j+=4)
+               vst1q_f32(norm+j, vmulq_n_f32(vaddq_f32(vld1q_f32(norm+j), vld1q_f32(norm2+j)), .5f));
+#endif
+            for (;j<norm_len;j++)
                norm[j] = (.5f*(norm[j]+norm2[j]));
+         }
       }
       if (dual_stereo)
       {
@@ -6460,14 +8258,14 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                                                                      , LM,
                last?
                    ((void *)0)
-                       :norm+M*eBands[i]-norm_offset, 1.0f, lowband_scratch, x_cm);
+                       :norm+Mband[i]-norm_offset, 1.0f, lowband_scratch, x_cm);
          y_cm = quant_band(&ctx, Y, N, b/2, B,
                effective_lowband != -1 ? norm2+effective_lowband : 
                                                                   ((void *)0)
                                                                       , LM,
                last?
                    ((void *)0)
-                       :norm2+M*eBands[i]-norm_offset, 1.0f, lowband_scratch, y_cm);
+                       :norm2+Mband[i]-norm_offset, 1.0f, lowband_scratch, y_cm);
       } else {
          if (Y!=
                ((void *)0)
@@ -6498,7 +8296,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                                                                            , LM,
                      last?
                          ((void *)0)
-                             :norm+M*eBands[i]-norm_offset, lowband_scratch, cm);
+                             :norm+Mband[i]-norm_offset, lowband_scratch, cm);
                dist0 = ((w[0])*(((void)(arch),celt_inner_prod_c(X_save, X, N)))) + ((w[1])*(((void)(arch),celt_inner_prod_c(Y_save, Y, N))));
 
 
@@ -6508,7 +8306,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                (memcpy((X_save2), (X), (N)*sizeof(*(X_save2)) + 0*((X_save2)-(X)) ));
                (memcpy((Y_save2), (Y), (N)*sizeof(*(Y_save2)) + 0*((Y_save2)-(Y)) ));
                if (!last)
-                  (memcpy((norm_save2), (norm+M*eBands[i]-norm_offset), (N)*sizeof(*(norm_save2)) + 0*((norm_save2)-(norm+M*eBands[i]-norm_offset)) ));
+                  (memcpy((norm_save2), (norm+Mband[i]-norm_offset), (N)*sizeof(*(norm_save2)) + 0*((norm_save2)-(norm+Mband[i]-norm_offset)) ));
                nstart_bytes = ec_save.offs;
                nend_bytes = ec_save.storage;
                bytes_buf = ec_save.buf+nstart_bytes;
@@ -6532,7 +8330,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                                                                            , LM,
                      last?
                          ((void *)0)
-                             :norm+M*eBands[i]-norm_offset, lowband_scratch, cm);
+                             :norm+Mband[i]-norm_offset, lowband_scratch, cm);
                dist1 = ((w[0])*(((void)(arch),celt_inner_prod_c(X_save, X, N)))) + ((w[1])*(((void)(arch),celt_inner_prod_c(Y_save, Y, N))));
                if (dist0 >= dist1) {
                   x_cm = cm2;
@@ -6541,7 +8339,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                   (memcpy((X), (X_save2), (N)*sizeof(*(X)) + 0*((X)-(X_save2)) ));
                   (memcpy((Y), (Y_save2), (N)*sizeof(*(Y)) + 0*((Y)-(Y_save2)) ));
                   if (!last)
-                     (memcpy((norm+M*eBands[i]-norm_offset), (norm_save2), (N)*sizeof(*(norm+M*eBands[i]-norm_offset)) + 0*((norm+M*eBands[i]-norm_offset)-(norm_save2)) ));
+                     (memcpy((norm+Mband[i]-norm_offset), (norm_save2), (N)*sizeof(*(norm+Mband[i]-norm_offset)) + 0*((norm+Mband[i]-norm_offset)-(norm_save2)) ));
                   (memcpy((bytes_buf), (bytes_save), (save_bytes)*sizeof(*(bytes_buf)) + 0*((bytes_buf)-(bytes_save)) ));
                }
             } else {
@@ -6552,7 +8350,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                                                                            , LM,
                      last?
                          ((void *)0)
-                             :norm+M*eBands[i]-norm_offset, lowband_scratch, x_cm|y_cm);
+                             :norm+Mband[i]-norm_offset, lowband_scratch, x_cm|y_cm);
             }
          } else {
             x_cm = quant_band(&ctx, X, N, b, B,
@@ -6561,7 +8359,7 @@ void quant_all_bands(int encode, const OpusCustomMode *m, int start, int end,
                                                                         , LM,
                   last?
                       ((void *)0)
-                          :norm+M*eBands[i]-norm_offset, 1.0f, lowband_scratch, x_cm|y_cm);
+                          :norm+Mband[i]-norm_offset, 1.0f, lowband_scratch, x_cm|y_cm);
          }
          y_cm = x_cm;
       }
@@ -6980,6 +8778,11 @@ void unquant_coarse_energy(const OpusCustomMode *m, int start, int end, opus_val
 
    for (i=start;i<end;i++)
    {
+      /* The Laplace parameters depend only on the band, not the channel,
+         so look them up once per band instead of once per channel. */
+      int pi = 2*((i) < (20) ? (i) : (20));
+      unsigned lap_fs = (unsigned)prob_model[pi]<<7;
+      int lap_decay = prob_model[pi+1]<<6;
       c=0;
       do {
          int qi;
@@ -6992,10 +8795,7 @@ void unquant_coarse_energy(const OpusCustomMode *m, int start, int end, opus_val
          tell = ec_tell(dec);
          if(budget-tell>=15)
          {
-            int pi;
-            pi = 2*((i) < (20) ? (i) : (20));
-            qi = ec_laplace_decode(dec,
-                  prob_model[pi]<<7, prob_model[pi+1]<<6);
+            qi = ec_laplace_decode(dec, lap_fs, lap_decay);
          }
          else if(budget-tell>=2)
          {
@@ -7331,15 +9131,16 @@ static inline int interp_bits2pulses(const OpusCustomMode *m, int start, int end
       for (j=end;j-->start;)
       {
          int tmp = bits1[j] + (mid*(opus_int32)bits2[j]>>6);
-         if (tmp >= thresh[j] || done)
-         {
-            done = 1;
-
-            psum += ((tmp) < (cap[j]) ? (tmp) : (cap[j]));
-         } else {
-            if (tmp >= alloc_floor)
-               psum += alloc_floor;
-         }
+         /* Branchless form of: bands at or above threshold (and every band
+            below the first such one) contribute min(tmp,cap), the rest
+            contribute alloc_floor when they can afford it. The compares
+            are unpredictable across bands, so masks beat branches here. */
+         int capped = ((tmp) < (cap[j]) ? (tmp) : (cap[j]));
+         int floor_term = alloc_floor & -(tmp >= alloc_floor);
+         opus_int32 dm;
+         done |= tmp >= thresh[j];
+         dm = -(opus_int32)done;
+         psum += (dm & capped) | (~dm & floor_term);
       }
       if (psum > total)
          hi = mid;
@@ -7352,14 +9153,12 @@ static inline int interp_bits2pulses(const OpusCustomMode *m, int start, int end
    for (j=end;j-->start;)
    {
       int tmp = bits1[j] + ((opus_int32)lo*bits2[j]>>6);
-      if (tmp < thresh[j] && !done)
-      {
-         if (tmp >= alloc_floor)
-            tmp = alloc_floor;
-         else
-            tmp = 0;
-      } else
-         done = 1;
+      /* Same mask trick as the bisection above: a band below threshold
+         with no threshold band after it is demoted to alloc_floor or 0. */
+      int raise = tmp >= thresh[j];
+      int rm = -(raise | done);
+      done |= raise;
+      tmp = (rm & tmp) | (~rm & (alloc_floor & -(tmp >= alloc_floor)));
 
       tmp = ((tmp) < (cap[j]) ? (tmp) : (cap[j]));
       bits[j] = tmp;
@@ -7625,6 +9424,7 @@ int clt_compute_allocation(const OpusCustomMode *m, int start, int end, const in
    int *bits2 = (int*)DR_OPUS_ALLOCA(sizeof(int)*(len));
    int *thresh = (int*)DR_OPUS_ALLOCA(sizeof(int)*(len));
    int *trim_offset = (int*)DR_OPUS_ALLOCA(sizeof(int)*(len));
+   int *band_scale = (int*)DR_OPUS_ALLOCA(sizeof(int)*(len));
 
    for (j=start;j<end;j++)
    {
@@ -7637,6 +9437,9 @@ int clt_compute_allocation(const OpusCustomMode *m, int start, int end, const in
 
       if ((m->eBands[j+1]-m->eBands[j])<<LM==1)
          trim_offset[j] -= C<<3;
+      /* C*N<<LM is invariant across the bisection; only the allocVectors
+         entry changes with mid, so hoist the per-band factor out here. */
+      band_scale[j] = C*(m->eBands[j+1]-m->eBands[j])<<LM;
    }
    lo = 1;
    hi = m->nbAllocVectors - 1;
@@ -7648,8 +9451,7 @@ int clt_compute_allocation(const OpusCustomMode *m, int start, int end, const in
       for (j=end;j-->start;)
       {
          int bitsj;
-         int N = m->eBands[j+1]-m->eBands[j];
-         bitsj = C*N*m->allocVectors[mid*len+j]<<LM>>2;
+         bitsj = band_scale[j]*m->allocVectors[mid*len+j]>>2;
          if (bitsj > 0)
             bitsj = ((0) > (bitsj + trim_offset[j]) ? (0) : (bitsj + trim_offset[j]));
          bitsj += offsets[j];
@@ -7675,10 +9477,9 @@ int clt_compute_allocation(const OpusCustomMode *m, int start, int end, const in
    for (j=start;j<end;j++)
    {
       int bits1j, bits2j;
-      int N = m->eBands[j+1]-m->eBands[j];
-      bits1j = C*N*m->allocVectors[lo*len+j]<<LM>>2;
+      bits1j = band_scale[j]*m->allocVectors[lo*len+j]>>2;
       bits2j = hi>=m->nbAllocVectors ?
-            cap[j] : C*N*m->allocVectors[hi*len+j]<<LM>>2;
+            cap[j] : band_scale[j]*m->allocVectors[hi*len+j]>>2;
       if (bits1j > 0)
          bits1j = ((0) > (bits1j + trim_offset[j]) ? (0) : (bits1j + trim_offset[j]));
       if (bits2j > 0)
@@ -7713,6 +9514,54 @@ static inline opus_int16 FLOAT2INT16(float x) {
    return (opus_int16)float2int(x);
 }
 
+/* Batch form of FLOAT2INT16 for whole output buffers. The vector paths
+   replicate the scalar sequence lane for lane - scale, clamp, add a
+   sign-matched 0.5 and truncate - so the rounding (half away from zero)
+   and saturation behaviour are identical to FLOAT2INT16. */
+static inline void celt_float2int16(const float * restrict in, opus_int16 * restrict out, int cnt)
+{
+   int i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   {
+      const __m128 vscale = _mm_set1_ps(32768.f);
+      const __m128 vlo = _mm_set1_ps(-32768.f);
+      const __m128 vhi = _mm_set1_ps(32767.f);
+      const __m128 vhalf = _mm_set1_ps(0.5f);
+      const __m128 vsign = _mm_set1_ps(-0.0f);
+      for (;i+8<=cnt;i+=8)
+      {
+         __m128 x0 = _mm_mul_ps(_mm_loadu_ps(in+i), vscale);
+         __m128 x1 = _mm_mul_ps(_mm_loadu_ps(in+i+4), vscale);
+         x0 = _mm_min_ps(_mm_max_ps(x0, vlo), vhi);
+         x1 = _mm_min_ps(_mm_max_ps(x1, vlo), vhi);
+         x0 = _mm_add_ps(x0, _mm_or_ps(vhalf, _mm_and_ps(x0, vsign)));
+         x1 = _mm_add_ps(x1, _mm_or_ps(vhalf, _mm_and_ps(x1, vsign)));
+         _mm_storeu_si128((__m128i*)(out+i),
+               _mm_packs_epi32(_mm_cvttps_epi32(x0), _mm_cvttps_epi32(x1)));
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   {
+      const float32x4_t vlo = vdupq_n_f32(-32768.f);
+      const float32x4_t vhi = vdupq_n_f32(32767.f);
+      const float32x4_t vhalf = vdupq_n_f32(0.5f);
+      const uint32x4_t vsign = vdupq_n_u32(0x80000000u);
+      for (;i+8<=cnt;i+=8)
+      {
+         float32x4_t x0 = vmulq_n_f32(vld1q_f32(in+i), 32768.f);
+         float32x4_t x1 = vmulq_n_f32(vld1q_f32(in+i+4), 32768.f);
+         x0 = vminq_f32(vmaxq_f32(x0, vlo), vhi);
+         x1 = vminq_f32(vmaxq_f32(x1, vlo), vhi);
+         x0 = vaddq_f32(x0, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vhalf), vandq_u32(vreinterpretq_u32_f32(x0), vsign))));
+         x1 = vaddq_f32(x1, vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vhalf), vandq_u32(vreinterpretq_u32_f32(x1), vsign))));
+         vst1q_s16(out+i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(x0)), vqmovn_s32(vcvtq_s32_f32(x1))));
+      }
+   }
+#endif
+   for (;i<cnt;i++)
+      out[i] = FLOAT2INT16(in[i]);
+}
+
 int resampling_factor(opus_int32 rate)
 {
    int ret;
@@ -7749,11 +9598,49 @@ void comb_filter_const_c(opus_val32 *y, opus_val32 *x, int T, int N,
 {
    opus_val32 x0, x1, x2, x3, x4;
    int i;
-   x4 = x[-T-2];
-   x3 = x[-T-1];
-   x2 = x[-T];
-   x1 = x[-T+1];
-   for (i=0;i<N;i++)
+   i = 0;
+   /* The filter may run in place (y==x) with a lag of at least 15, so the
+      taps read samples the scalar loop has already produced; as long as the
+      furthest-ahead tap (i-T+2 plus three lanes) stays behind the current
+      block of stores, a four-wide pass sees exactly the values the scalar
+      loop would, and each lane repeats the scalar op sequence. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   if (T >= 7)
+   {
+      const __m128 vg10 = _mm_set1_ps(g10);
+      const __m128 vg11 = _mm_set1_ps(g11);
+      const __m128 vg12 = _mm_set1_ps(g12);
+      for (;i+4<=N;i+=4)
+      {
+         __m128 vx2 = _mm_loadu_ps(x+i-T);
+         __m128 s1 = _mm_add_ps(_mm_loadu_ps(x+i-T+1), _mm_loadu_ps(x+i-T-1));
+         __m128 s2 = _mm_add_ps(_mm_loadu_ps(x+i-T+2), _mm_loadu_ps(x+i-T-2));
+         __m128 vy = _mm_add_ps(_mm_loadu_ps(x+i), _mm_mul_ps(vg10, vx2));
+         vy = _mm_add_ps(vy, _mm_mul_ps(vg11, s1));
+         vy = _mm_add_ps(vy, _mm_mul_ps(vg12, s2));
+         _mm_storeu_ps(y+i, vy);
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   if (T >= 7)
+   {
+      for (;i+4<=N;i+=4)
+      {
+         float32x4_t vx2 = vld1q_f32(x+i-T);
+         float32x4_t s1 = vaddq_f32(vld1q_f32(x+i-T+1), vld1q_f32(x+i-T-1));
+         float32x4_t s2 = vaddq_f32(vld1q_f32(x+i-T+2), vld1q_f32(x+i-T-2));
+         float32x4_t vy = vaddq_f32(vld1q_f32(x+i), vmulq_n_f32(vx2, g10));
+         vy = vaddq_f32(vy, vmulq_n_f32(s1, g11));
+         vy = vaddq_f32(vy, vmulq_n_f32(s2, g12));
+         vst1q_f32(y+i, vy);
+      }
+   }
+#endif
+   x4 = x[i-T-2];
+   x3 = x[i-T-1];
+   x2 = x[i-T];
+   x1 = x[i-T+1];
+   for (;i<N;i++)
    {
       x0=x[i-T+2];
       y[i] = x[i]
@@ -7802,14 +9689,63 @@ void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
    g10 = ((g1)*(gains[tapset1][0]));
    g11 = ((g1)*(gains[tapset1][1]));
    g12 = ((g1)*(gains[tapset1][2]));
-   x1 = x[-T1+1];
-   x2 = x[-T1 ];
-   x3 = x[-T1-1];
-   x4 = x[-T1-2];
-
    if (g0==g1 && T0==T1 && tapset0==tapset1)
       overlap=0;
-   for (i=0;i<overlap;i++)
+   i = 0;
+   /* The crossfade outputs are independent per sample; both lags are at
+      least 15, so even in place every tap reads values that are final by
+      the time the current block stores (same argument as in
+      comb_filter_const_c), and each lane repeats the scalar op order. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+   if (T0 >= 7 && T1 >= 7)
+   {
+      const __m128 one = _mm_set1_ps(1.0f);
+      const __m128 vg00 = _mm_set1_ps(g00);
+      const __m128 vg01 = _mm_set1_ps(g01);
+      const __m128 vg02 = _mm_set1_ps(g02);
+      const __m128 vg10 = _mm_set1_ps(g10);
+      const __m128 vg11 = _mm_set1_ps(g11);
+      const __m128 vg12 = _mm_set1_ps(g12);
+      for (;i+4<=overlap;i+=4)
+      {
+         __m128 w = _mm_loadu_ps(window+i);
+         __m128 f = _mm_mul_ps(w, w);
+         __m128 omf = _mm_sub_ps(one, f);
+         __m128 vy = _mm_loadu_ps(x+i);
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(omf, vg00), _mm_loadu_ps(x+i-T0)));
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(omf, vg01), _mm_add_ps(_mm_loadu_ps(x+i-T0+1), _mm_loadu_ps(x+i-T0-1))));
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(omf, vg02), _mm_add_ps(_mm_loadu_ps(x+i-T0+2), _mm_loadu_ps(x+i-T0-2))));
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(f, vg10), _mm_loadu_ps(x+i-T1)));
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(f, vg11), _mm_add_ps(_mm_loadu_ps(x+i-T1+1), _mm_loadu_ps(x+i-T1-1))));
+         vy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(f, vg12), _mm_add_ps(_mm_loadu_ps(x+i-T1+2), _mm_loadu_ps(x+i-T1-2))));
+         _mm_storeu_ps(y+i, vy);
+      }
+   }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+   if (T0 >= 7 && T1 >= 7)
+   {
+      const float32x4_t one = vdupq_n_f32(1.0f);
+      for (;i+4<=overlap;i+=4)
+      {
+         float32x4_t w = vld1q_f32(window+i);
+         float32x4_t f = vmulq_f32(w, w);
+         float32x4_t omf = vsubq_f32(one, f);
+         float32x4_t vy = vld1q_f32(x+i);
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(omf, g00), vld1q_f32(x+i-T0)));
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(omf, g01), vaddq_f32(vld1q_f32(x+i-T0+1), vld1q_f32(x+i-T0-1))));
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(omf, g02), vaddq_f32(vld1q_f32(x+i-T0+2), vld1q_f32(x+i-T0-2))));
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(f, g10), vld1q_f32(x+i-T1)));
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(f, g11), vaddq_f32(vld1q_f32(x+i-T1+1), vld1q_f32(x+i-T1-1))));
+         vy = vaddq_f32(vy, vmulq_f32(vmulq_n_f32(f, g12), vaddq_f32(vld1q_f32(x+i-T1+2), vld1q_f32(x+i-T1-2))));
+         vst1q_f32(y+i, vy);
+      }
+   }
+#endif
+   x1 = x[i-T1+1];
+   x2 = x[i-T1 ];
+   x3 = x[i-T1-1];
+   x4 = x[i-T1-2];
+   for (;i<overlap;i++)
    {
       opus_val16 f;
       x0=x[i-T1+2];
@@ -8060,8 +9996,56 @@ void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, c
 
       if (downsample>1)
       {
-
-         for (j=0;j<N;j++)
+         /* Same recurrence as the 48kHz path below, but the unscaled
+            samples land in scratch for the decimation pass; reuse the
+            4-wide chain expansion with a plain store. */
+         j = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         {
+            const float c2f = coef0*coef0;
+            const float c3f = c2f*coef0;
+            const __m128 eps  = _mm_set1_ps(1e-30f);
+            const __m128 k    = _mm_setr_ps(1.0f, coef0, c2f, c3f);
+            const __m128 c1v  = _mm_set1_ps(coef0);
+            const __m128 c2v  = _mm_set1_ps(c2f);
+            const __m128 c3v  = _mm_set1_ps(c3f);
+            for (; j+4<=N; j+=4)
+            {
+               __m128  t   = _mm_add_ps(_mm_loadu_ps(x+j), eps);
+               __m128i ti  = _mm_castps_si128(t);
+               __m128  acc = t;
+               acc = _mm_add_ps(acc, _mm_mul_ps(c1v, _mm_castsi128_ps(_mm_slli_si128(ti, 4))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(c2v, _mm_castsi128_ps(_mm_slli_si128(ti, 8))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(c3v, _mm_castsi128_ps(_mm_slli_si128(ti, 12))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(m), k));
+               m = coef0*_mm_cvtss_f32(_mm_shuffle_ps(acc, acc, _MM_SHUFFLE(3, 3, 3, 3)));
+               _mm_storeu_ps(scratch+j, acc);
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         {
+            const float c2f = coef0*coef0;
+            const float c3f = c2f*coef0;
+            const float32x4_t eps  = vdupq_n_f32(1e-30f);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            float32x4_t k;
+            k = vsetq_lane_f32(1.0f,  vdupq_n_f32(0.0f), 0);
+            k = vsetq_lane_f32(coef0, k, 1);
+            k = vsetq_lane_f32(c2f,   k, 2);
+            k = vsetq_lane_f32(c3f,   k, 3);
+            for (; j+4<=N; j+=4)
+            {
+               float32x4_t t   = vaddq_f32(vld1q_f32(x+j), eps);
+               float32x4_t acc = vmlaq_n_f32(t,   vextq_f32(zero, t, 3), coef0);
+               acc             = vmlaq_n_f32(acc, vextq_f32(zero, t, 2), c2f);
+               acc             = vmlaq_n_f32(acc, vextq_f32(zero, t, 1), c3f);
+               acc             = vmlaq_n_f32(acc, k, m);
+               m = coef0*vgetq_lane_f32(acc, 3);
+               vst1q_f32(scratch+j, acc);
+            }
+         }
+#endif
+         for (;j<N;j++)
          {
             celt_sig tmp = x[j] + 1e-30f + m;
             m = ((coef0)*(tmp));
@@ -8069,8 +10053,80 @@ void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, c
          }
          apply_downsampling=1;
       } else {
+         /* Hot path (48kHz, no custom-mode preemphasis tilt). The recurrence
+            m' = coef0*(x+m) is serialized per sample, so process 4 samples per
+            iteration by expanding the chain: lane i accumulates
+            sum(coef0^(i-k)*t[k], k<=i) + coef0^i*m, built from lane-shifted
+            copies of the input block. Cross-block state stays the scalar m. */
+         j = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
          {
-            for (j=0;j<N;j++)
+            const float c2f = coef0*coef0;
+            const float c3f = c2f*coef0;
+            const __m128 eps  = _mm_set1_ps(1e-30f);
+            const __m128 k    = _mm_setr_ps(1.0f, coef0, c2f, c3f);
+            const __m128 c1v  = _mm_set1_ps(coef0);
+            const __m128 c2v  = _mm_set1_ps(c2f);
+            const __m128 c3v  = _mm_set1_ps(c3f);
+            const __m128 gain = _mm_set1_ps(1/32768.f);
+            for (; j+4<=N; j+=4)
+            {
+               __m128  t   = _mm_add_ps(_mm_loadu_ps(x+j), eps);
+               __m128i ti  = _mm_castps_si128(t);
+               __m128  acc = t;
+               acc = _mm_add_ps(acc, _mm_mul_ps(c1v, _mm_castsi128_ps(_mm_slli_si128(ti, 4))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(c2v, _mm_castsi128_ps(_mm_slli_si128(ti, 8))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(c3v, _mm_castsi128_ps(_mm_slli_si128(ti, 12))));
+               acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(m), k));
+               m = coef0*_mm_cvtss_f32(_mm_shuffle_ps(acc, acc, _MM_SHUFFLE(3, 3, 3, 3)));
+               acc = _mm_mul_ps(acc, gain);
+               if (C == 1)
+                  _mm_storeu_ps(y+j, acc);
+               else
+               {
+                  float o[4];
+                  _mm_storeu_ps(o, acc);
+                  y[(j+0)*C] = o[0];
+                  y[(j+1)*C] = o[1];
+                  y[(j+2)*C] = o[2];
+                  y[(j+3)*C] = o[3];
+               }
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         {
+            const float c2f = coef0*coef0;
+            const float c3f = c2f*coef0;
+            const float32x4_t eps  = vdupq_n_f32(1e-30f);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            float32x4_t k;
+            k = vsetq_lane_f32(1.0f,  vdupq_n_f32(0.0f), 0);
+            k = vsetq_lane_f32(coef0, k, 1);
+            k = vsetq_lane_f32(c2f,   k, 2);
+            k = vsetq_lane_f32(c3f,   k, 3);
+            for (; j+4<=N; j+=4)
+            {
+               float32x4_t t   = vaddq_f32(vld1q_f32(x+j), eps);
+               float32x4_t acc = vmlaq_n_f32(t,   vextq_f32(zero, t, 3), coef0);
+               acc             = vmlaq_n_f32(acc, vextq_f32(zero, t, 2), c2f);
+               acc             = vmlaq_n_f32(acc, vextq_f32(zero, t, 1), c3f);
+               acc             = vmlaq_n_f32(acc, k, m);
+               m = coef0*vgetq_lane_f32(acc, 3);
+               acc = vmulq_n_f32(acc, 1/32768.f);
+               if (C == 1)
+                  vst1q_f32(y+j, acc);
+               else
+               {
+                  y[(j+0)*C] = vgetq_lane_f32(acc, 0);
+                  y[(j+1)*C] = vgetq_lane_f32(acc, 1);
+                  y[(j+2)*C] = vgetq_lane_f32(acc, 2);
+                  y[(j+3)*C] = vgetq_lane_f32(acc, 3);
+               }
+            }
+         }
+#endif
+         {
+            for (;j<N;j++)
             {
                celt_sig tmp = x[j] + 1e-30f + m;
                m = ((coef0)*(tmp));
@@ -8082,10 +10138,57 @@ void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, c
 
       if (apply_downsampling)
       {
+         j = 0;
+         /* Every output is a single multiply of one gathered sample, so the
+            vector forms below are bit-identical to the scalar loop. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         {
+            const __m128 gain = _mm_set1_ps(1/32768.f);
+            for (;j+4<=Nd;j+=4)
+            {
+               __m128 v = _mm_mul_ps(downsample==1 ? _mm_loadu_ps(scratch+j) :
+                     _mm_setr_ps(scratch[(j+0)*downsample], scratch[(j+1)*downsample],
+                                 scratch[(j+2)*downsample], scratch[(j+3)*downsample]), gain);
+               if (C == 1)
+                  _mm_storeu_ps(y+j, v);
+               else
+               {
+                  float o[4];
+                  _mm_storeu_ps(o, v);
+                  y[(j+0)*C] = o[0];
+                  y[(j+1)*C] = o[1];
+                  y[(j+2)*C] = o[2];
+                  y[(j+3)*C] = o[3];
+               }
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         for (;j+4<=Nd;j+=4)
          {
-            for (j=0;j<Nd;j++)
-               y[j*C] = (((scratch[j*downsample]))*(1/32768.f));
+            float32x4_t v;
+            if (downsample == 1)
+               v = vld1q_f32(scratch+j);
+            else
+            {
+               v = vdupq_n_f32(scratch[(j+0)*downsample]);
+               v = vsetq_lane_f32(scratch[(j+1)*downsample], v, 1);
+               v = vsetq_lane_f32(scratch[(j+2)*downsample], v, 2);
+               v = vsetq_lane_f32(scratch[(j+3)*downsample], v, 3);
+            }
+            v = vmulq_n_f32(v, 1/32768.f);
+            if (C == 1)
+               vst1q_f32(y+j, v);
+            else
+            {
+               y[(j+0)*C] = vgetq_lane_f32(v, 0);
+               y[(j+1)*C] = vgetq_lane_f32(v, 1);
+               y[(j+2)*C] = vgetq_lane_f32(v, 2);
+               y[(j+3)*C] = vgetq_lane_f32(v, 3);
+            }
          }
+#endif
+         for (;j<Nd;j++)
+            y[j*C] = (((scratch[j*downsample]))*(1/32768.f));
       }
    } while (++c<C);
    ;
@@ -8205,9 +10308,12 @@ static void tf_decode(int start, int end, int isTransient, int *tf_res, int LM,
    {
       tf_select = ec_dec_bit_logp(dec, 1);
    }
-   for (i=start;i<end;i++)
    {
-      tf_res[i] = tf_select_table[LM][4*isTransient+2*tf_select+tf_res[i]];
+      /* LM, isTransient and tf_select are fixed by now, so resolve the
+         table row once and map each band through its two entries. */
+      const signed char *row = &tf_select_table[LM][4*isTransient+2*tf_select];
+      for (i=start;i<end;i++)
+         tf_res[i] = row[tf_res[i]];
    }
 }
 
@@ -8250,10 +10356,13 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
    overlap = mode->overlap;
    eBands = mode->eBands;
 
-   c=0; do {
-      decode_mem[c] = st->_decode_mem + c*(2048 +overlap);
+   decode_mem[0] = st->_decode_mem;
+   out_syn[0] = decode_mem[0]+2048 -N;
+   for (c=1;c<C;c++)
+   {
+      decode_mem[c] = decode_mem[c-1] + (2048 +overlap);
       out_syn[c] = decode_mem[c]+2048 -N;
-   } while (++c<C);
+   }
    lpc = (opus_val16*)(st->_decode_mem+(2048 +overlap)*C);
    oldBandE = lpc+C*24;
    oldLogE = oldBandE + 2*nbEBands;
@@ -8356,8 +10465,9 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
          int j;
 
          buf = decode_mem[c];
-         for (i=0;i<1024 +24;i++)
-            exc[i-24] = (buf[2048 -1024 -24 +i]);
+         /* opus_val16 and celt_sig are both float here, so the history
+            tail can be block-copied instead of moved a sample at a time. */
+         (memcpy((exc-24), (buf+2048 -1024 -24), (1024 +24)*sizeof(*(exc-24)) + 0*((exc-24)-(buf+2048 -1024 -24)) ));
 
          if (loss_duration == 0)
          {
@@ -8413,7 +10523,7 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
                E2 += (((opus_val32)(e)*(opus_val32)(e)));
             }
             E1 = ((E1) < (E2) ? (E1) : (E2));
-            decay = ((float)sqrt(((float)((E1))/(E2))));
+            decay = (sqrtf(((float)((E1))/(E2))));
          }
 
 
@@ -8430,16 +10540,49 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
          extrapolation_len = N+overlap;
 
          attenuation = ((fade)*(decay));
-         for (i=j=0;i<extrapolation_len;i++,j++)
+         /* attenuation only changes when j wraps past pitch_index (at least
+            100 samples apart), so the excitation copy runs vectorized over
+            each constant-attenuation segment. The S1 energy sum stays a
+            separate scalar loop so its accumulation order is untouched; it
+            decides the S1 > 0.2*S2 test below. The copy never overwrites
+            the samples that loop reads (they sit pitch_index behind the
+            store region). */
+         i = j = 0;
+         while (i < extrapolation_len)
          {
-            opus_val16 tmp;
+            int seg, k;
+            seg = pitch_index - j;
+            if (seg > extrapolation_len - i)
+               seg = extrapolation_len - i;
+            k = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+            {
+               const __m128 att = _mm_set1_ps(attenuation);
+               for (; k+4<=seg; k+=4)
+                  _mm_storeu_ps(&buf[2048 -N+i+k],
+                        _mm_mul_ps(att, _mm_loadu_ps(&exc[extrapolation_offset+j+k])));
+            }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+            for (; k+4<=seg; k+=4)
+               vst1q_f32(&buf[2048 -N+i+k],
+                     vmulq_n_f32(vld1q_f32(&exc[extrapolation_offset+j+k]), attenuation));
+#endif
+            for (; k<seg; k++)
+               buf[2048 -N+i+k] =
+                     ((((attenuation)*(exc[extrapolation_offset+j+k]))))
+                                                                      ;
+            i += seg;
+            j += seg;
             if (j >= pitch_index) {
                j -= pitch_index;
                attenuation = ((attenuation)*(decay));
             }
-            buf[2048 -N+i] =
-                  ((((attenuation)*(exc[extrapolation_offset+j]))))
-                                                                 ;
+         }
+         for (i=j=0;i<extrapolation_len;i++,j++)
+         {
+            opus_val16 tmp;
+            if (j >= pitch_index)
+               j -= pitch_index;
 
 
             tmp = (buf[2048 -1024 -N+extrapolation_offset+j])
@@ -8450,8 +10593,22 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
          {
             opus_val16 lpc_mem[24];
 
-
-            for (i=0;i<24;i++)
+            /* Reversed 24-sample copy of the synthesis history, 4 wide. */
+            i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+            for (; i+4<=24; i+=4)
+            {
+               __m128 v = _mm_loadu_ps(&buf[2048 -N-4-i]);
+               _mm_storeu_ps(&lpc_mem[i], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3)));
+            }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+            for (; i+4<=24; i+=4)
+            {
+               float32x4_t v = vrev64q_f32(vld1q_f32(&buf[2048 -N-4-i]));
+               vst1q_f32(&lpc_mem[i], vextq_f32(v, v, 2));
+            }
+#endif
+            for (;i<24;i++)
                lpc_mem[i] = (buf[2048 -N-1-i]);
 
 
@@ -8483,19 +10640,61 @@ static void celt_decode_lost(OpusCustomDecoder * restrict st, int N, int LM)
             if (!(S1 > 0.2f*S2))
 
             {
-               for (i=0;i<extrapolation_len;i++)
-                  buf[2048 -N+i] = 0;
+               memset(buf+2048 -N, 0, extrapolation_len*sizeof(*buf));
             } else if (S1 < S2)
             {
-               opus_val16 ratio = ((float)sqrt(((float)((S1)+1)/(S2+1))));
-               for (i=0;i<overlap;i++)
+               opus_val16 ratio = (sqrtf(((float)((S1)+1)/(S2+1))));
+               /* Elementwise scaling; the vector forms keep the scalar
+                  mul-then-sub order so the output bits are unchanged. */
+               i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+               {
+                  const __m128 one = _mm_set1_ps(1.0f);
+                  const __m128 omr = _mm_set1_ps(1.0f -ratio);
+                  const __m128 rv  = _mm_set1_ps(ratio);
+                  for (; i+4<=overlap; i+=4)
+                  {
+                     __m128 g = _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(window+i), omr));
+                     _mm_storeu_ps(&buf[2048 -N+i], _mm_mul_ps(g, _mm_loadu_ps(&buf[2048 -N+i])));
+                  }
+                  for (; i<overlap; i++)
+                  {
+                     opus_val16 tmp_g = 1.0f
+                           - ((window[i])*(1.0f -ratio));
+                     buf[2048 -N+i] =
+                           ((tmp_g)*(buf[2048 -N+i]));
+                  }
+                  for (; i+4<=extrapolation_len; i+=4)
+                     _mm_storeu_ps(&buf[2048 -N+i], _mm_mul_ps(rv, _mm_loadu_ps(&buf[2048 -N+i])));
+               }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+               {
+                  const float32x4_t one = vdupq_n_f32(1.0f);
+                  for (; i+4<=overlap; i+=4)
+                  {
+                     float32x4_t g = vsubq_f32(one, vmulq_n_f32(vld1q_f32(window+i), 1.0f -ratio));
+                     vst1q_f32(&buf[2048 -N+i], vmulq_f32(g, vld1q_f32(&buf[2048 -N+i])));
+                  }
+                  for (; i<overlap; i++)
+                  {
+                     opus_val16 tmp_g = 1.0f
+                           - ((window[i])*(1.0f -ratio));
+                     buf[2048 -N+i] =
+                           ((tmp_g)*(buf[2048 -N+i]));
+                  }
+                  for (; i+4<=extrapolation_len; i+=4)
+                     vst1q_f32(&buf[2048 -N+i], vmulq_n_f32(vld1q_f32(&buf[2048 -N+i]), ratio));
+               }
+#else
+               for (; i<overlap; i++)
                {
                   opus_val16 tmp_g = 1.0f
                         - ((window[i])*(1.0f -ratio));
                   buf[2048 -N+i] =
                         ((tmp_g)*(buf[2048 -N+i]));
                }
-               for (i=overlap;i<extrapolation_len;i++)
+#endif
+               for (; i<extrapolation_len; i++)
                {
                   buf[2048 -N+i] =
                         ((ratio)*(buf[2048 -N+i]));
@@ -8641,10 +10840,13 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
       return -1;
 
    N = M*mode->shortMdctSize;
-   c=0; do {
-      decode_mem[c] = st->_decode_mem + c*(2048 +overlap);
+   decode_mem[0] = st->_decode_mem;
+   out_syn[0] = decode_mem[0]+2048 -N;
+   for (c=1;c<CC;c++)
+   {
+      decode_mem[c] = decode_mem[c-1] + (2048 +overlap);
       out_syn[c] = decode_mem[c]+2048 -N;
-   } while (++c<CC);
+   }
 
    effEnd = end;
    if (effEnd > mode->effEBands)
@@ -8674,7 +10876,22 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
 
    if (C==1)
    {
-      for (i=0;i<nbEBands;i++)
+      /* maxps/minps pick the second operand on a false compare, exactly
+         like the scalar ternaries here; the NEON selects do the same. */
+      i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      for (;i+4<=nbEBands;i+=4)
+         _mm_storeu_ps(oldBandE+i,
+               _mm_max_ps(_mm_loadu_ps(oldBandE+i), _mm_loadu_ps(oldBandE+nbEBands+i)));
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for (;i+4<=nbEBands;i+=4)
+      {
+         float32x4_t a = vld1q_f32(oldBandE+i);
+         float32x4_t b = vld1q_f32(oldBandE+nbEBands+i);
+         vst1q_f32(oldBandE+i, vbslq_f32(vcgtq_f32(a, b), a, b));
+      }
+#endif
+      for (;i<nbEBands;i++)
          oldBandE[i]=((oldBandE[i]) > (oldBandE[nbEBands+i]) ? (oldBandE[i]) : (oldBandE[nbEBands+i]));
    }
 
@@ -8731,7 +10948,11 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
    unquant_coarse_energy(mode, start, end, oldBandE,
          intra_ener, dec, C, LM);
 
-   int *tf_res = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
+   /* One arena for the six per-band int arrays used below; they are
+      all nbEBands long and live for the rest of the frame, so a single
+      allocation keeps them on the same cache lines. */
+   int *band_scratch = (int*)DR_OPUS_ALLOCA(sizeof(int)*(6*nbEBands));
+   int *tf_res = band_scratch;
    tf_decode(start, end, isTransient, tf_res, LM, dec);
 
    tell = ec_tell(dec);
@@ -8739,11 +10960,11 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
    if (tell+4 <= total_bits)
       spread_decision = ec_dec_icdf(dec, spread_icdf, 5);
 
-   int *cap = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
+   int *cap = band_scratch + nbEBands;
 
    init_caps(mode,cap,LM,C);
 
-   int *offsets = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
+   int *offsets = band_scratch + 2*nbEBands;
 
    dynalloc_logp = 6;
    total_bits<<=3;
@@ -8776,7 +10997,7 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
          dynalloc_logp = ((2) > (dynalloc_logp-1) ? (2) : (dynalloc_logp-1));
    }
 
-   int *fine_quant = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
+   int *fine_quant = band_scratch + 3*nbEBands;
    alloc_trim = tell+(6<<3) <= total_bits ?
          ec_dec_icdf(dec, trim_icdf, 7) : 5;
 
@@ -8784,8 +11005,8 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
    anti_collapse_rsv = isTransient&&LM>=2&&bits>=((LM+2)<<3) ? (1<<3) : 0;
    bits -= anti_collapse_rsv;
 
-   int *pulses = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
-   int *fine_priority = (int*)DR_OPUS_ALLOCA(sizeof(int)*(nbEBands));
+   int *pulses = band_scratch + 4*nbEBands;
+   int *fine_priority = band_scratch + 5*nbEBands;
 
    codedBands = clt_compute_allocation(mode, start, end, offsets, cap,
          alloc_trim, &intensity, &dual_stereo, bits, &balance, pulses,
@@ -8838,18 +11059,23 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
    celt_synthesis(mode, X, out_syn, oldBandE, start, effEnd,
                   C, CC, isTransient, LM, st->downsample, silence, st->arch);
 
-   c=0; do {
-      st->postfilter_period=((st->postfilter_period) > (15) ? (st->postfilter_period) : (15));
-      st->postfilter_period_old=((st->postfilter_period_old) > (15) ? (st->postfilter_period_old) : (15));
-      comb_filter(out_syn[c], out_syn[c], st->postfilter_period_old, st->postfilter_period, mode->shortMdctSize,
-            st->postfilter_gain_old, st->postfilter_gain, st->postfilter_tapset_old, st->postfilter_tapset,
-            mode->window, overlap, st->arch);
-      if (LM!=0)
-         comb_filter(out_syn[c]+mode->shortMdctSize, out_syn[c]+mode->shortMdctSize, st->postfilter_period, postfilter_pitch, N-mode->shortMdctSize,
-               st->postfilter_gain, postfilter_gain, st->postfilter_tapset, postfilter_tapset,
+   /* The clamps are idempotent on scalar state, so do them once instead of
+      per channel; the loop body then only reads st. */
+   st->postfilter_period=((st->postfilter_period) > (15) ? (st->postfilter_period) : (15));
+   st->postfilter_period_old=((st->postfilter_period_old) > (15) ? (st->postfilter_period_old) : (15));
+   {
+      int shortMdctSize = mode->shortMdctSize;
+      c=0; do {
+         comb_filter(out_syn[c], out_syn[c], st->postfilter_period_old, st->postfilter_period, shortMdctSize,
+               st->postfilter_gain_old, st->postfilter_gain, st->postfilter_tapset_old, st->postfilter_tapset,
                mode->window, overlap, st->arch);
+         if (LM!=0)
+            comb_filter(out_syn[c]+shortMdctSize, out_syn[c]+shortMdctSize, st->postfilter_period, postfilter_pitch, N-shortMdctSize,
+                  st->postfilter_gain, postfilter_gain, st->postfilter_tapset, postfilter_tapset,
+                  mode->window, overlap, st->arch);
 
-   } while (++c<CC);
+      } while (++c<CC);
+   }
    st->postfilter_period_old = st->postfilter_period;
    st->postfilter_gain_old = st->postfilter_gain;
    st->postfilter_tapset_old = st->postfilter_tapset;
@@ -8866,32 +11092,96 @@ int celt_decode_with_ec(OpusCustomDecoder * restrict st, const unsigned char *da
    if (C==1)
       (memcpy((&oldBandE[nbEBands]), (oldBandE), (nbEBands)*sizeof(*(&oldBandE[nbEBands])) + 0*((&oldBandE[nbEBands])-(oldBandE)) ));
 
+   max_background_increase = ((160) < (st->loss_duration+M) ? (160) : (st->loss_duration+M))*(0.001f);
+
    if (!isTransient)
    {
       (memcpy((oldLogE2), (oldLogE), (2*nbEBands)*sizeof(*(oldLogE2)) + 0*((oldLogE2)-(oldLogE)) ));
       (memcpy((oldLogE), (oldBandE), (2*nbEBands)*sizeof(*(oldLogE)) + 0*((oldLogE)-(oldBandE)) ));
+      i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      {
+         const __m128 inc = _mm_set1_ps(max_background_increase);
+         for (;i+4<=2*nbEBands;i+=4)
+            _mm_storeu_ps(backgroundLogE+i,
+                  _mm_min_ps(_mm_add_ps(_mm_loadu_ps(backgroundLogE+i), inc),
+                             _mm_loadu_ps(oldBandE+i)));
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for (;i+4<=2*nbEBands;i+=4)
+      {
+         float32x4_t a = vaddq_f32(vld1q_f32(backgroundLogE+i), vdupq_n_f32(max_background_increase));
+         float32x4_t b = vld1q_f32(oldBandE+i);
+         vst1q_f32(backgroundLogE+i, vbslq_f32(vcltq_f32(a, b), a, b));
+      }
+#endif
+      for (;i<2*nbEBands;i++)
+         backgroundLogE[i] = ((backgroundLogE[i] + max_background_increase) < (oldBandE[i]) ? (backgroundLogE[i] + max_background_increase) : (oldBandE[i]));
    } else {
-      for (i=0;i<2*nbEBands;i++)
+      /* Fused pass: oldBandE is loaded once and feeds both the oldLogE
+         clamp and the backgroundLogE update. */
+      i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+      {
+         const __m128 inc = _mm_set1_ps(max_background_increase);
+         for (;i+4<=2*nbEBands;i+=4)
+         {
+            __m128 obe = _mm_loadu_ps(oldBandE+i);
+            __m128 bg  = _mm_add_ps(_mm_loadu_ps(backgroundLogE+i), inc);
+            _mm_storeu_ps(oldLogE+i, _mm_min_ps(_mm_loadu_ps(oldLogE+i), obe));
+            _mm_storeu_ps(backgroundLogE+i, _mm_min_ps(bg, obe));
+         }
+      }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+      for (;i+4<=2*nbEBands;i+=4)
+      {
+         float32x4_t obe = vld1q_f32(oldBandE+i);
+         float32x4_t ole = vld1q_f32(oldLogE+i);
+         float32x4_t bg  = vaddq_f32(vld1q_f32(backgroundLogE+i), vdupq_n_f32(max_background_increase));
+         vst1q_f32(oldLogE+i, vbslq_f32(vcltq_f32(ole, obe), ole, obe));
+         vst1q_f32(backgroundLogE+i, vbslq_f32(vcltq_f32(bg, obe), bg, obe));
+      }
+#endif
+      for (;i<2*nbEBands;i++)
+      {
          oldLogE[i] = ((oldLogE[i]) < (oldBandE[i]) ? (oldLogE[i]) : (oldBandE[i]));
+         backgroundLogE[i] = ((backgroundLogE[i] + max_background_increase) < (oldBandE[i]) ? (backgroundLogE[i] + max_background_increase) : (oldBandE[i]));
+      }
    }
 
-
-
-   max_background_increase = ((160) < (st->loss_duration+M) ? (160) : (st->loss_duration+M))*(0.001f);
-   for (i=0;i<2*nbEBands;i++)
-      backgroundLogE[i] = ((backgroundLogE[i] + max_background_increase) < (oldBandE[i]) ? (backgroundLogE[i] + max_background_increase) : (oldBandE[i]));
-
    c=0; do
    {
-      for (i=0;i<start;i++)
-      {
-         oldBandE[c*nbEBands+i]=0;
-         oldLogE[c*nbEBands+i]=oldLogE2[c*nbEBands+i]=-(28.f);
-      }
-      for (i=end;i<nbEBands;i++)
+      int r;
+      for (r=0;r<2;r++)
       {
-         oldBandE[c*nbEBands+i]=0;
-         oldLogE[c*nbEBands+i]=oldLogE2[c*nbEBands+i]=-(28.f);
+         int b0 = r ? end : 0;
+         int n  = r ? nbEBands-end : start;
+         opus_val16 *e  = &oldBandE[c*nbEBands+b0];
+         opus_val16 *l1 = &oldLogE[c*nbEBands+b0];
+         opus_val16 *l2 = &oldLogE2[c*nbEBands+b0];
+         memset(e, 0, n*sizeof(*e));
+         i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+         {
+            const __m128 v = _mm_set1_ps(-(28.f));
+            for (;i+4<=n;i+=4)
+            {
+               _mm_storeu_ps(l1+i, v);
+               _mm_storeu_ps(l2+i, v);
+            }
+         }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+         {
+            const float32x4_t v = vdupq_n_f32(-(28.f));
+            for (;i+4<=n;i+=4)
+            {
+               vst1q_f32(l1+i, v);
+               vst1q_f32(l2+i, v);
+            }
+         }
+#endif
+         for (;i<n;i++)
+            l1[i]=l2[i]=-(28.f);
       }
    } while (++c<2);
    st->rng = dec->rng;
@@ -8914,7 +11204,7 @@ int opus_custom_decode_float(OpusCustomDecoder * restrict st, const unsigned cha
 
 int opus_custom_decode(OpusCustomDecoder * restrict st, const unsigned char *data, int len, opus_int16 * restrict pcm, int frame_size)
 {
-   int j, ret, C, N;
+   int ret, C, N;
    ;
    ;
 
@@ -8927,13 +11217,12 @@ int opus_custom_decode(OpusCustomDecoder * restrict st, const unsigned char *dat
    N = frame_size;
    celt_sig *out = (celt_sig*)DR_OPUS_ALLOCA(sizeof(celt_sig)*(C*N));
 
-   ret=celt_decode_with_ec(st, data, len, out, frame_size, 
+   ret=celt_decode_with_ec(st, data, len, out, frame_size,
                                                           ((void *)0)
                                                               , 0);
 
    if (ret>0)
-      for (j=0;j<C*ret;j++)
-         pcm[j] = FLOAT2INT16 (out[j]);
+      celt_float2int16(out, pcm, C*ret);
 
    ;
    return ret;
@@ -9188,8 +11477,13 @@ static inline opus_int32 silk_CLZ16(opus_int16 in16)
 
 static inline opus_int32 silk_CLZ32(opus_int32 in32)
 {
+#if defined(DR_OPUS_SUPPORT_LZCNT)
+    /* lzcnt is defined for zero input, so no guard branch is needed. */
+    return (opus_int32)_lzcnt_u32((unsigned)in32);
+#else
     return in32 ? 32 - (((int)sizeof(unsigned)*8
                       )-(__builtin_clz(in32))) : 32;
+#endif
 }
 int silk_resampler_init(
     silk_resampler_state_struct *S,
@@ -9505,16 +11799,11 @@ opus_int64 silk_inner_prod16_c(
 );
 static inline opus_int32 silk_ROR32( opus_int32 a32, int rot )
 {
+    /* Branch-free right rotate; negative rot rotates left. Masking both
+       shift counts to 0..31 keeps the rot == 0 case defined and lets the
+       compiler emit a single ror instruction. */
     opus_uint32 x = (opus_uint32) a32;
-    opus_uint32 r = (opus_uint32) rot;
-    opus_uint32 m = (opus_uint32) -rot;
-    if( rot == 0 ) {
-        return a32;
-    } else if( rot < 0 ) {
-        return (opus_int32) ((x << m) | (x >> (32 - m)));
-    } else {
-        return (opus_int32) ((x << (32 - r)) | (x >> r));
-    }
+    return (opus_int32) ((x >> (rot & 31)) | (x << ((-rot) & 31)));
 }
 static inline int silk_min_int(int a, int b)
 {
@@ -9880,19 +12169,22 @@ typedef struct {
 
 
 typedef struct {
-    opus_int32 pitchL_Q8;
-    opus_int16 LTPCoef_Q14[ 5 ];
-    opus_int16 prevLPC_Q12[ 16 ];
-    int last_frame_lost;
+    /* Scalars first, pairing the two int16 fields so nothing pads; the
+       coefficient arrays only get copied in bulk on PLC updates and sit
+       at the end. */
     opus_int32 rand_seed;
     opus_int16 randScale_Q14;
+    opus_int16 prevLTP_scale_Q14;
     opus_int32 conc_energy;
     int conc_energy_shift;
-    opus_int16 prevLTP_scale_Q14;
-    opus_int32 prevGain_Q16[ 2 ];
+    int last_frame_lost;
+    opus_int32 pitchL_Q8;
     int fs_kHz;
     int nb_subfr;
     int subfr_length;
+    opus_int32 prevGain_Q16[ 2 ];
+    opus_int16 LTPCoef_Q14[ 5 ];
+    opus_int16 prevLPC_Q12[ 16 ];
 } silk_PLC_struct;
 
 
@@ -9911,7 +12203,11 @@ typedef struct {
 typedef struct {
     opus_int32 prev_gain_Q16;
     opus_int32 exc_Q14[ ( ( 5 * 4 ) * 16 ) ];
-    opus_int32 sLPC_Q14_buf[ 16 ];
+    /* First 16 entries are the persistent LPC history; the rest is the
+       in-place whole-frame workspace for silk_decode_core, which writes
+       subframes at sliding offsets so each one finds its history in the 16
+       samples just before it, then copies the final 16 back to the front. */
+    opus_int32 sLPC_Q14_buf[ 16 + ( ( 5 * 4 ) * 16 ) ];
     opus_int16 outBuf[ ( ( 5 * 4 ) * 16 ) + 2 * ( 5 * 16 ) ];
     int lagPrev;
     opus_int8 LastGainIndex;
@@ -9956,6 +12252,14 @@ typedef struct {
 
     silk_PLC_struct sPLC;
 
+    /* Persistent scratch for silk_decode_core, sized for the worst case
+       (20 ms at 16 kHz).  Holding these in the state instead of re-allocating
+       them every frame keeps the working set warm across decodes. */
+    opus_int16 scratch_sLTP[ ( ( 5 * 4 ) * 16 ) ];
+    opus_int32 scratch_sLTP_Q15[ 2 * ( ( 5 * 4 ) * 16 ) ];
+    opus_int32 scratch_res_Q14[ ( 5 * 16 ) ];
+    opus_int16 scratch_pulses[ ( ( 5 * 4 ) * 16 ) ];
+
 } silk_decoder_state;
 
 
@@ -10236,7 +12540,7 @@ void silk_decode_signs(
     int length,
     const int signalType,
     const int quantOffsetType,
-    const int sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ]
+    const opus_uint16 sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ]
 );
 
 
@@ -10566,8 +12870,38 @@ int silk_init_decoder(
     return(0);
 }
 
+/* Saturating 32-bit add, equivalent to the expanded sign-test macro form
+   used elsewhere: the 64-bit sum only leaves int32 range on a genuine
+   overflow, and clamping it reproduces the same saturated result. */
+static inline opus_int32 silk_add_sat32(opus_int32 a, opus_int32 b)
+{
+    opus_int64 t = (opus_int64)a + (opus_int64)b;
+    t = t > 0x7FFFFFFF ? 0x7FFFFFFF : t;
+    t = t < (opus_int32)0x80000000 ? (opus_int32)0x80000000 : t;
+    return (opus_int32)t;
+}
+
+/* Left shift by 4 with saturation: clamp to the representable pre-shift
+   range, then shift. */
+static inline opus_int32 silk_lshift_sat32_4(opus_int32 a)
+{
+    a = a > (0x7FFFFFFF>>4) ? (0x7FFFFFFF>>4) : a;
+    a = a < (((opus_int32)0x80000000)>>4) ? (((opus_int32)0x80000000)>>4) : a;
+    return (opus_int32)((opus_uint32)a << 4);
+}
 
+/* Rounded right shift, matching the expanded macro form used throughout
+   the SILK fixed-point code. */
+static inline opus_int32 silk_rshift_round(opus_int32 x, int s)
+{
+    return s == 1 ? ( x >> 1 ) + ( x & 1 ) : ( ( x >> ( s - 1 ) ) + 1 ) >> 1;
+}
 
+/* Saturate to int16. */
+static inline opus_int16 silk_sat16(opus_int32 x)
+{
+    return (opus_int16)( x > 0x7FFF ? 0x7FFF : ( x < (opus_int16)0x8000 ? (opus_int16)0x8000 : x ) );
+}
 
 void silk_decode_core(
     silk_decoder_state *psDec,
@@ -10578,21 +12912,27 @@ void silk_decode_core(
 )
 {
     int i, k, lag = 0, start_idx, sLTP_buf_idx, NLSF_interpolation_flag, signalType;
-    opus_int16 *A_Q12, *B_Q14, *pxq, A_Q12_tmp[ 16 ];
+    opus_int16 *A_Q12, *B_Q14, *pxq;
     ;
     ;
     opus_int32 LTP_pred_Q13, LPC_pred_Q10, Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
-    opus_int32 *pred_lag_ptr, *pexc_Q14, *pres_Q14;
+    opus_int32 *pred_lag_ptr, *pexc_Q14, *pres_Q14, *psLPC;
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+    opus_int32 A_rev32[ 16 ];
+    int n_grp;
+#else
+    opus_int16 A_Q12_tmp[ 16 ];
+#endif
     ;
     ;
     ;
 
     ;
 
-    opus_int16 *sLTP = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*(psDec->ltp_mem_length));
-    opus_int32 *sLTP_Q15 = (opus_int32*)DR_OPUS_ALLOCA(sizeof(opus_int32)*(psDec->ltp_mem_length + psDec->frame_length));
-    opus_int32 *res_Q14 = (opus_int32*)DR_OPUS_ALLOCA(sizeof(opus_int32)*(psDec->subfr_length));
-    opus_int32 *sLPC_Q14 = (opus_int32*)DR_OPUS_ALLOCA(sizeof(opus_int32)*(psDec->subfr_length + 16));
+    opus_int16 *sLTP = psDec->scratch_sLTP;
+    opus_int32 *sLTP_Q15 = psDec->scratch_sLTP_Q15;
+    opus_int32 *res_Q14 = psDec->scratch_res_Q14;
+    opus_int32 *sLPC_Q14 = psDec->sLPC_Q14_buf;
 
     offset_Q10 = silk_Quantization_Offsets_Q10[ psDec->indices.signalType >> 1 ][ psDec->indices.quantOffsetType ];
 
@@ -10604,41 +12944,118 @@ void silk_decode_core(
 
 
     rand_seed = psDec->indices.Seed;
-    for( i = 0; i < psDec->frame_length; i++ ) {
-        rand_seed = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((rand_seed)) * (opus_uint32)((196314165))))));
-        psDec->exc_Q14[ i ] = ((opus_int32)((opus_uint32)((opus_int32)pulses[ i ])<<(14)));
-        if( psDec->exc_Q14[ i ] > 0 ) {
-            psDec->exc_Q14[ i ] -= 80 << 4;
-        } else
-        if( psDec->exc_Q14[ i ] < 0 ) {
-            psDec->exc_Q14[ i ] += 80 << 4;
+    i = 0;
+    /* The seed recurrence folds each pulse back in, so it stays a short
+       scalar chain; the excitation conditioning (shift, +-80<<4 tweak,
+       offset, seed-sign flip) is lane-parallel and runs 4 wide with the
+       branches turned into compare masks. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+    {
+        const __m128i off  = _mm_set1_epi32( offset_Q10 << 4 );
+        const __m128i adj  = _mm_set1_epi32( 80 << 4 );
+        const __m128i zero = _mm_setzero_si128();
+        for( ; i + 4 <= psDec->frame_length; i += 4 ) {
+            opus_int32 seeds[ 4 ];
+            __m128i p, e, sm;
+            int j;
+            for( j = 0; j < 4; j++ ) {
+                rand_seed = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((rand_seed)) * (opus_uint32)((196314165))))));
+                seeds[ j ] = rand_seed;
+                rand_seed = ((opus_int32)((opus_uint32)(rand_seed) + (opus_uint32)(pulses[ i + j ])));
+            }
+            p = _mm_setr_epi32( pulses[ i ], pulses[ i + 1 ], pulses[ i + 2 ], pulses[ i + 3 ] );
+            e = _mm_slli_epi32( p, 14 );
+            e = _mm_sub_epi32( e, _mm_and_si128( _mm_cmpgt_epi32( e, zero ), adj ) );
+            e = _mm_add_epi32( e, _mm_and_si128( _mm_cmplt_epi32( e, zero ), adj ) );
+            e = _mm_add_epi32( e, off );
+            sm = _mm_srai_epi32( _mm_loadu_si128( (const __m128i *)seeds ), 31 );
+            e = _mm_sub_epi32( _mm_xor_si128( e, sm ), sm );
+            _mm_storeu_si128( (__m128i *)&psDec->exc_Q14[ i ], e );
         }
-        psDec->exc_Q14[ i ] += offset_Q10 << 4;
-        if( rand_seed < 0 ) {
-           psDec->exc_Q14[ i ] = -psDec->exc_Q14[ i ];
+    }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+    {
+        const int32x4_t off = vdupq_n_s32( offset_Q10 << 4 );
+        const int32x4_t adj = vdupq_n_s32( 80 << 4 );
+        const int32x4_t zero = vdupq_n_s32( 0 );
+        for( ; i + 4 <= psDec->frame_length; i += 4 ) {
+            opus_int32 seeds[ 4 ];
+            int32x4_t p, e, sm;
+            int j;
+            for( j = 0; j < 4; j++ ) {
+                rand_seed = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((rand_seed)) * (opus_uint32)((196314165))))));
+                seeds[ j ] = rand_seed;
+                rand_seed = ((opus_int32)((opus_uint32)(rand_seed) + (opus_uint32)(pulses[ i + j ])));
+            }
+            p = vmovl_s16( vld1_s16( &pulses[ i ] ) );
+            e = vshlq_n_s32( p, 14 );
+            e = vsubq_s32( e, vandq_s32( vreinterpretq_s32_u32( vcgtq_s32( e, zero ) ), adj ) );
+            e = vaddq_s32( e, vandq_s32( vreinterpretq_s32_u32( vcltq_s32( e, zero ) ), adj ) );
+            e = vaddq_s32( e, off );
+            sm = vshrq_n_s32( vld1q_s32( seeds ), 31 );
+            e = vsubq_s32( veorq_s32( e, sm ), sm );
+            vst1q_s32( &psDec->exc_Q14[ i ], e );
         }
+    }
+#endif
+    for( ; i < psDec->frame_length; i++ ) {
+        opus_int32 e, m;
+        rand_seed = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((rand_seed)) * (opus_uint32)((196314165))))));
+        /* Branchless form of the +-80<<4 tweak and the seed-sign flip; the
+           sequential masks are exact because a positive e is at least 1<<14,
+           so subtracting 80<<4 can never drive it negative. */
+        e = ((opus_int32)((opus_uint32)((opus_int32)pulses[ i ])<<(14)));
+        e -= ( 80 << 4 ) & -( e > 0 );
+        e += ( 80 << 4 ) & -( e < 0 );
+        e += offset_Q10 << 4;
+        m = rand_seed >> 31;
+        psDec->exc_Q14[ i ] = ( e ^ m ) - m;
 
         rand_seed = ((opus_int32)((opus_uint32)(rand_seed) + (opus_uint32)(pulses[ i ])));
     }
 
 
-    memcpy((sLPC_Q14), (psDec->sLPC_Q14_buf), (16 * sizeof( opus_int32 )));
-
     pexc_Q14 = psDec->exc_Q14;
     pxq = xq;
     sLTP_buf_idx = psDec->ltp_mem_length;
 
     for( k = 0; k < psDec->nb_subfr; k++ ) {
         pres_Q14 = res_Q14;
+        /* Subframes land at sliding offsets, so each one's 16-sample
+           history is simply the tail of the previous subframe's output
+           and nothing has to be shifted between iterations. */
+        psLPC = &sLPC_Q14[ k * psDec->subfr_length ];
         A_Q12 = psDecCtrl->PredCoef_Q12[ k >> 1 ];
 
 
+#if defined(DR_OPUS_SUPPORT_SSE2) || defined(DR_OPUS_SUPPORT_NEON)
+        {
+            /* Coefficients widened and reversed in groups of four, so a
+               4-wide load of the descending state history lines up with its
+               taps. Order 10 pads its last group with zero taps, which
+               contribute exactly zero to the wrapping sum, so the kernel
+               needs no per-sample order test. The padded lanes read two
+               extra history entries, which always exist in the 16-sample
+               prefix. This repack is the only coefficient copy; the old
+               A_Q12_tmp staging buffer would just be an extra pass. */
+            int g;
+            n_grp = ( psDec->LPC_order + 3 ) >> 2;
+            for( g = 0; g < psDec->LPC_order; g++ ) {
+                A_rev32[ ( g & ~3 ) + ( 3 - ( g & 3 ) ) ] = A_Q12[ g ];
+            }
+            for( ; g < ( n_grp << 2 ); g++ ) {
+                A_rev32[ ( g & ~3 ) + ( 3 - ( g & 3 ) ) ] = 0;
+            }
+        }
+#else
+        /* Stack copy so the per-sample coefficient reads are provably
+           disjoint from the sLPC_Q14 stores in the prediction loop. */
         memcpy((A_Q12_tmp), (A_Q12), (psDec->LPC_order * sizeof( opus_int16 )));
+#endif
         B_Q14 = &psDecCtrl->LTPCoef_Q14[ k * 5 ];
         signalType = psDec->indices.signalType;
 
         Gain_Q10 = ((psDecCtrl->Gains_Q16[ k ])>>(6));
-        inv_gain_Q31 = silk_INVERSE32_varQ( psDecCtrl->Gains_Q16[ k ], 47 );
 
 
         if( psDecCtrl->Gains_Q16[ k ] != psDec->prev_gain_Q16 ) {
@@ -10646,7 +13063,7 @@ void silk_decode_core(
 
 
             for( i = 0; i < 16; i++ ) {
-                sLPC_Q14[ i ] = ((opus_int32)(((opus_int64)(gain_adj_Q16) * (sLPC_Q14[ i ])) >> 16));
+                psLPC[ i ] = ((opus_int32)(((opus_int64)(gain_adj_Q16) * (psLPC[ i ])) >> 16));
             }
         } else {
             gain_adj_Q16 = (opus_int32)1 << 16;
@@ -10684,7 +13101,10 @@ void silk_decode_core(
                 silk_LPC_analysis_filter( &sLTP[ start_idx ], &psDec->outBuf[ start_idx + k * psDec->subfr_length ],
                     A_Q12, psDec->ltp_mem_length - start_idx, psDec->LPC_order, arch );
 
-
+                /* The inverse gain is only consumed by this whitening
+                   branch, so the Newton-Raphson divide runs here instead
+                   of once per subframe. */
+                inv_gain_Q31 = silk_INVERSE32_varQ( psDecCtrl->Gains_Q16[ k ], 47 );
                 if( k == 0 ) {
 
                     inv_gain_Q31 = ((opus_int32)((opus_uint32)(((opus_int32)(((inv_gain_Q31) * (opus_int64)((opus_int16)(psDecCtrl->LTP_scale_Q14))) >> 16)))<<(2)));
@@ -10706,7 +13126,64 @@ void silk_decode_core(
         if( signalType == 2 ) {
 
             pred_lag_ptr = &sLTP_Q15[ sLTP_buf_idx - lag + 5 / 2 ];
+            /* Taps 1..4 read four consecutive history samples, so they run
+               as one vector group with the coefficients reversed, using the
+               same exact high-product split as the LPC kernel below; tap 0
+               stays scalar. Samples remain serial because the loop feeds
+               its own output back at distance lag - 2. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+            {
+                const __m128i lomask = _mm_set1_epi32( 0xFFFF );
+                const __m128i b = _mm_setr_epi32( B_Q14[ 4 ], B_Q14[ 3 ], B_Q14[ 2 ], B_Q14[ 1 ] );
+                const __m128i bsh = _mm_slli_epi32( b, 16 );
+                for( i = 0; i < psDec->subfr_length; i++ ) {
+                    opus_int32 res;
+                    __m128i s    = _mm_loadu_si128( (const __m128i *)&pred_lag_ptr[ -4 ] );
+                    __m128i hi   = _mm_madd_epi16( _mm_srli_epi32( s, 16 ), b );
+                    __m128i lo   = _mm_madd_epi16( _mm_and_si128( s, lomask ), b );
+                    __m128i corr = _mm_and_si128( _mm_srai_epi32( _mm_slli_epi32( s, 16 ), 31 ), bsh );
+                    __m128i t    = _mm_add_epi32( hi, _mm_srai_epi32( _mm_add_epi32( lo, corr ), 16 ) );
+                    t = _mm_add_epi32( t, _mm_shuffle_epi32( t, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+                    t = _mm_add_epi32( t, _mm_shuffle_epi32( t, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+                    LTP_pred_Q13 = 2;
+                    LTP_pred_Q13 = ((opus_int32)((LTP_pred_Q13) + (((pred_lag_ptr[ 0 ]) * (opus_int64)((opus_int16)(B_Q14[ 0 ]))) >> 16)));
+                    LTP_pred_Q13 = (opus_int32)((opus_uint32)LTP_pred_Q13 + (opus_uint32)_mm_cvtsi128_si32( t ));
+                    pred_lag_ptr++;
+
+                    res = (((pexc_Q14[ i ])) + (((opus_int32)((opus_uint32)((LTP_pred_Q13))<<((1))))));
+                    pres_Q14[ i ] = res;
+                    sLTP_Q15[ sLTP_buf_idx ] = ((opus_int32)((opus_uint32)(res)<<(1)));
+                    sLTP_buf_idx++;
+                }
+            }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+            {
+                const opus_int32 B_rev32[ 4 ] = { B_Q14[ 4 ], B_Q14[ 3 ], B_Q14[ 2 ], B_Q14[ 1 ] };
+                const int32x4_t b   = vld1q_s32( B_rev32 );
+                const int16x4_t b16 = vmovn_s32( b );
+                const int32x4_t bsh = vshlq_n_s32( b, 16 );
+                for( i = 0; i < psDec->subfr_length; i++ ) {
+                    opus_int32 res;
+                    int32x4_t s    = vld1q_s32( &pred_lag_ptr[ -4 ] );
+                    int32x4_t hi   = vmull_s16( vmovn_s32( vshrq_n_s32( s, 16 ) ), b16 );
+                    int32x4_t lo   = vmull_s16( vmovn_s32( s ), b16 );
+                    int32x4_t corr = vandq_s32( vshrq_n_s32( vshlq_n_s32( s, 16 ), 31 ), bsh );
+                    int32x4_t t    = vaddq_s32( hi, vshrq_n_s32( vaddq_s32( lo, corr ), 16 ) );
+                    int32x2_t t2   = vadd_s32( vget_low_s32( t ), vget_high_s32( t ) );
+                    LTP_pred_Q13 = 2;
+                    LTP_pred_Q13 = ((opus_int32)((LTP_pred_Q13) + (((pred_lag_ptr[ 0 ]) * (opus_int64)((opus_int16)(B_Q14[ 0 ]))) >> 16)));
+                    LTP_pred_Q13 = (opus_int32)((opus_uint32)LTP_pred_Q13 + (opus_uint32)vget_lane_s32( vpadd_s32( t2, t2 ), 0 ));
+                    pred_lag_ptr++;
+
+                    res = (((pexc_Q14[ i ])) + (((opus_int32)((opus_uint32)((LTP_pred_Q13))<<((1))))));
+                    pres_Q14[ i ] = res;
+                    sLTP_Q15[ sLTP_buf_idx ] = ((opus_int32)((opus_uint32)(res)<<(1)));
+                    sLTP_buf_idx++;
+                }
+            }
+#else
             for( i = 0; i < psDec->subfr_length; i++ ) {
+                opus_int32 res;
 
 
                 LTP_pred_Q13 = 2;
@@ -10717,56 +13194,178 @@ void silk_decode_core(
                 LTP_pred_Q13 = ((opus_int32)((LTP_pred_Q13) + (((pred_lag_ptr[ -4 ]) * (opus_int64)((opus_int16)(B_Q14[ 4 ]))) >> 16)));
                 pred_lag_ptr++;
 
-
-                pres_Q14[ i ] = (((pexc_Q14[ i ])) + (((opus_int32)((opus_uint32)((LTP_pred_Q13))<<((1))))));
-
-
-                sLTP_Q15[ sLTP_buf_idx ] = ((opus_int32)((opus_uint32)(pres_Q14[ i ])<<(1)));
+                /* Both stores come from the same register instead of
+                   reading pres_Q14[ i ] back right after writing it. */
+                res = (((pexc_Q14[ i ])) + (((opus_int32)((opus_uint32)((LTP_pred_Q13))<<((1))))));
+                pres_Q14[ i ] = res;
+                sLTP_Q15[ sLTP_buf_idx ] = ((opus_int32)((opus_uint32)(res)<<(1)));
                 sLTP_buf_idx++;
             }
+#endif
         } else {
             pres_Q14 = pexc_Q14;
         }
 
-        for( i = 0; i < psDec->subfr_length; i++ ) {
+        /* Each tap is (sLPC * A) >> 16, which always fits in 32 bits,
+           and the accumulation is wrapping int32 addition, so the taps
+           can be summed in any order without changing the result. The
+           vector paths below split the 32x16 multiply into
+           s_hi*a + ((s_lo_u*a) >> 16) on 16-bit lanes, which is the
+           exact high product per tap. The scalar path is unswitched on
+           the LPC order once per subframe instead of testing it per
+           sample. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+        {
+            const __m128i lomask = _mm_set1_epi32( 0xFFFF );
+            for( i = 0; i < psDec->subfr_length; i++ ) {
+                __m128i acc = _mm_setzero_si128();
+                int g;
+                for( g = 0; g < n_grp; g++ ) {
+                    __m128i s    = _mm_loadu_si128( (const __m128i *)&psLPC[ 16 + i - 4*( g + 1 ) ] );
+                    __m128i a    = _mm_loadu_si128( (const __m128i *)&A_rev32[ 4*g ] );
+                    __m128i hi   = _mm_madd_epi16( _mm_srli_epi32( s, 16 ), a );
+                    __m128i lo   = _mm_madd_epi16( _mm_and_si128( s, lomask ), a );
+                    __m128i corr = _mm_and_si128( _mm_srai_epi32( _mm_slli_epi32( s, 16 ), 31 ),
+                                                  _mm_slli_epi32( a, 16 ) );
+                    lo  = _mm_add_epi32( lo, corr );
+                    acc = _mm_add_epi32( acc, _mm_add_epi32( hi, _mm_srai_epi32( lo, 16 ) ) );
+                }
+                acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+                acc = _mm_add_epi32( acc, _mm_shuffle_epi32( acc, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+                LPC_pred_Q10 = ((psDec->LPC_order)>>(1));
+                LPC_pred_Q10 = (opus_int32)((opus_uint32)LPC_pred_Q10 + (opus_uint32)_mm_cvtsi128_si32( acc ));
 
-            ;
 
-            LPC_pred_Q10 = ((psDec->LPC_order)>>(1));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 1 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 0 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 2 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 1 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 3 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 2 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 4 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 3 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 5 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 4 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 6 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 5 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 7 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 6 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 8 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 7 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 9 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 8 ]))) >> 16)));
-            LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 10 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 9 ]))) >> 16)));
-            if( psDec->LPC_order == 16 ) {
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 11 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 10 ]))) >> 16)));
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 12 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 11 ]))) >> 16)));
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 13 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 12 ]))) >> 16)));
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 14 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 13 ]))) >> 16)));
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 15 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 14 ]))) >> 16)));
-                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((sLPC_Q14[ 16 + i - 16 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 15 ]))) >> 16)));
+                psLPC[ 16 + i ] = silk_add_sat32( pres_Q14[ i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
+            }
+            /* Output pass, 4 wide over the finished subframe. The gain
+               multiply is the exact SMULWW truncated to 32 bits: unsigned
+               32x32 products shifted right 16, with the operand-sign
+               corrections (which only touch bits >= 16) subtracted mod
+               2^32.  The rounded >>8 mirrors the scalar
+               ((x >> 7) + 1) >> 1 and packs_epi32 is the int16
+               saturation. */
+            {
+                const __m128i gv   = _mm_set1_epi32( Gain_Q10 );
+                const __m128i gsh  = _mm_slli_epi32( gv, 16 );
+                const __m128i gneg = _mm_srai_epi32( gv, 31 );
+                const __m128i one  = _mm_set1_epi32( 1 );
+                for( i = 0; i + 4 <= psDec->subfr_length; i += 4 ) {
+                    __m128i s  = _mm_loadu_si128( (const __m128i *)&psLPC[ 16 + i ] );
+                    __m128i pe = _mm_srli_epi64( _mm_mul_epu32( s, gv ), 16 );
+                    __m128i po = _mm_srli_epi64( _mm_mul_epu32( _mm_srli_si128( s, 4 ), gv ), 16 );
+                    __m128i x  = _mm_unpacklo_epi32( _mm_shuffle_epi32( pe, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                                                     _mm_shuffle_epi32( po, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+                    x = _mm_sub_epi32( x, _mm_and_si128( _mm_srai_epi32( s, 31 ), gsh ) );
+                    x = _mm_sub_epi32( x, _mm_and_si128( gneg, _mm_slli_epi32( s, 16 ) ) );
+                    x = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( x, 7 ), one ), 1 );
+                    _mm_storel_epi64( (__m128i *)&pxq[ i ], _mm_packs_epi32( x, x ) );
+                }
+            }
+            for( ; i < psDec->subfr_length; i++ ) {
+                pxq[ i ] = silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(psLPC[ 16 + i ]) * (Gain_Q10)) >> 16), 8 ) );
+            }
+        }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+        {
+            for( i = 0; i < psDec->subfr_length; i++ ) {
+                int32x4_t acc = vdupq_n_s32( 0 );
+                int32x2_t acc2;
+                int g;
+                for( g = 0; g < n_grp; g++ ) {
+                    int32x4_t s    = vld1q_s32( &psLPC[ 16 + i - 4*( g + 1 ) ] );
+                    int32x4_t a    = vld1q_s32( &A_rev32[ 4*g ] );
+                    int16x4_t a16  = vmovn_s32( a );
+                    int32x4_t hi   = vmull_s16( vmovn_s32( vshrq_n_s32( s, 16 ) ), a16 );
+                    int32x4_t lo   = vmull_s16( vmovn_s32( s ), a16 );
+                    int32x4_t corr = vandq_s32( vshrq_n_s32( vshlq_n_s32( s, 16 ), 31 ),
+                                                vshlq_n_s32( a, 16 ) );
+                    lo  = vaddq_s32( lo, corr );
+                    acc = vaddq_s32( acc, vaddq_s32( hi, vshrq_n_s32( lo, 16 ) ) );
+                }
+                acc2 = vadd_s32( vget_low_s32( acc ), vget_high_s32( acc ) );
+                LPC_pred_Q10 = ((psDec->LPC_order)>>(1));
+                LPC_pred_Q10 = (opus_int32)((opus_uint32)LPC_pred_Q10 + (opus_uint32)vget_lane_s32( vpadd_s32( acc2, acc2 ), 0 ));
+
+
+                psLPC[ 16 + i ] = silk_add_sat32( pres_Q14[ i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
+            }
+            /* Output pass, 4 wide: vmull_s32 is the exact signed 32x32
+               product and vshrn takes bits 16..47, i.e. the SMULWW result
+               truncated to 32 bits; vrshr matches the scalar rounded >>8
+               and vqmovn is the int16 saturation. */
+            {
+                const int32x2_t gv = vdup_n_s32( Gain_Q10 );
+                for( i = 0; i + 4 <= psDec->subfr_length; i += 4 ) {
+                    int32x4_t s  = vld1q_s32( &psLPC[ 16 + i ] );
+                    int32x2_t lo = vshrn_n_s64( vmull_s32( vget_low_s32( s ), gv ), 16 );
+                    int32x2_t hi = vshrn_n_s64( vmull_s32( vget_high_s32( s ), gv ), 16 );
+                    int32x4_t x  = vrshrq_n_s32( vcombine_s32( lo, hi ), 8 );
+                    vst1_s16( &pxq[ i ], vqmovn_s32( x ) );
+                }
+            }
+            for( ; i < psDec->subfr_length; i++ ) {
+                pxq[ i ] = silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(psLPC[ 16 + i ]) * (Gain_Q10)) >> 16), 8 ) );
+            }
+        }
+#else
+        if( psDec->LPC_order == 16 ) {
+            for( i = 0; i < psDec->subfr_length; i++ ) {
+                LPC_pred_Q10 = ((psDec->LPC_order)>>(1));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 1 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 0 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 2 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 1 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 3 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 2 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 4 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 3 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 5 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 4 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 6 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 5 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 7 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 6 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 8 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 7 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 9 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 8 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 10 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 9 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 11 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 10 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 12 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 11 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 13 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 12 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 14 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 13 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 15 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 14 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 16 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 15 ]))) >> 16)));
+
+
+                psLPC[ 16 + i ] = silk_add_sat32( pres_Q14[ i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
+
+
+                pxq[ i ] = silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(psLPC[ 16 + i ]) * (Gain_Q10)) >> 16), 8 ) );
             }
+        } else {
+            for( i = 0; i < psDec->subfr_length; i++ ) {
+                LPC_pred_Q10 = ((psDec->LPC_order)>>(1));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 1 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 0 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 2 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 1 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 3 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 2 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 4 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 3 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 5 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 4 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 6 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 5 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 7 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 6 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 8 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 7 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 9 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 8 ]))) >> 16)));
+                LPC_pred_Q10 = ((opus_int32)((LPC_pred_Q10) + (((psLPC[ 16 + i - 10 ]) * (opus_int64)((opus_int16)(A_Q12_tmp[ 9 ]))) >> 16)));
 
 
-            sLPC_Q14[ 16 + i ] = ((((opus_uint32)(pres_Q14[ i ]) + (opus_uint32)((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? ((((pres_Q14[ i ]) & ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) != 0 ? ((opus_int32)0x80000000) : (pres_Q14[ i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) : ((((pres_Q14[ i ]) | ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? 0x7FFFFFFF : (pres_Q14[ i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) );
+                psLPC[ 16 + i ] = silk_add_sat32( pres_Q14[ i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
 
 
-            pxq[ i ] = (opus_int16)((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14[ 16 + i ]) * (Gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1))));
+                pxq[ i ] = silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(psLPC[ 16 + i ]) * (Gain_Q10)) >> 16), 8 ) );
+            }
         }
+#endif
 
 
-        memcpy((sLPC_Q14), (&sLPC_Q14[ psDec->subfr_length ]), (16 * sizeof( opus_int32 )));
         pexc_Q14 += psDec->subfr_length;
         pxq += psDec->subfr_length;
     }
 
-
-    memcpy((psDec->sLPC_Q14_buf), (sLPC_Q14), (16 * sizeof( opus_int32 )));
+    /* One copy per frame parks the final 16-sample history at the front of
+       the buffer, where the next frame, PLC and CNG expect it. */
+    memcpy((sLPC_Q14), (&sLPC_Q14[ psDec->frame_length ]), (16 * sizeof( opus_int32 )));
     ;
 }
 int silk_decode_frame(
@@ -10794,8 +13393,7 @@ int silk_decode_frame(
         ( lostFlag == 2 && psDec->LBRR_flags[ psDec->nFramesDecoded ] == 1 ) )
     {
         ;
-        opus_int16 *pulses = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*((L + 16 - 1) & ~(16 - 1)))
-                                                                    ;
+        opus_int16 *pulses = psDec->scratch_pulses;
 
 
 
@@ -10890,11 +13488,39 @@ void silk_decode_parameters(
 
     if( psDec->indices.NLSFInterpCoef_Q2 < 4 ) {
 
-
+        /* Element-wise lerp over at most 16 int16 lanes.  The product
+           coef * diff needs 18 bits (coef <= 3, |diff| <= 32767), so the
+           16-bit lanes carry it as a mullo/mulhi pair; the shifted result
+           is back in int16 range, and both arrays are padded to 16
+           entries, so the lanes past LPC_order are computed harmlessly. */
+#if defined(DR_OPUS_SUPPORT_SSE2)
+        {
+            const __m128i c = _mm_set1_epi16( (short)psDec->indices.NLSFInterpCoef_Q2 );
+            for( i = 0; i < 16; i += 8 ) {
+                __m128i a  = _mm_loadu_si128( (const __m128i *)&psDec->prevNLSF_Q15[ i ] );
+                __m128i d  = _mm_sub_epi16( _mm_loadu_si128( (const __m128i *)&pNLSF_Q15[ i ] ), a );
+                __m128i lo = _mm_mullo_epi16( d, c );
+                __m128i hi = _mm_mulhi_epi16( d, c );
+                __m128i s  = _mm_or_si128( _mm_srli_epi16( lo, 2 ), _mm_slli_epi16( hi, 14 ) );
+                _mm_storeu_si128( (__m128i *)&pNLSF0_Q15[ i ], _mm_add_epi16( a, s ) );
+            }
+        }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+        {
+            const int16x4_t c = vdup_n_s16( (opus_int16)psDec->indices.NLSFInterpCoef_Q2 );
+            for( i = 0; i < 16; i += 4 ) {
+                int16x4_t a = vld1_s16( &psDec->prevNLSF_Q15[ i ] );
+                int16x4_t d = vsub_s16( vld1_s16( &pNLSF_Q15[ i ] ), a );
+                int32x4_t p = vshrq_n_s32( vmull_s16( d, c ), 2 );
+                vst1_s16( &pNLSF0_Q15[ i ], vadd_s16( a, vmovn_s32( p ) ) );
+            }
+        }
+#else
         for( i = 0; i < psDec->LPC_order; i++ ) {
             pNLSF0_Q15[ i ] = psDec->prevNLSF_Q15[ i ] + ((((psDec->indices.NLSFInterpCoef_Q2) * (pNLSF_Q15[ i ] - psDec->prevNLSF_Q15[ i ])))>>(2))
                                                                 ;
         }
+#endif
 
 
         silk_NLSF2A( psDecCtrl->PredCoef_Q12[ 0 ], pNLSF0_Q15, psDec->LPC_order, psDec->arch );
@@ -10903,7 +13529,10 @@ void silk_decode_parameters(
         memcpy((psDecCtrl->PredCoef_Q12[ 0 ]), (psDecCtrl->PredCoef_Q12[ 1 ]), (psDec->LPC_order * sizeof( opus_int16 )));
     }
 
-    memcpy((psDec->prevNLSF_Q15), (pNLSF_Q15), (psDec->LPC_order * sizeof( opus_int16 )));
+    /* Constant 32-byte size so the copy inlines to two vector moves
+       instead of a sized libc call; both arrays are 16 entries and the
+       lanes past LPC_order are never read. */
+    memcpy((psDec->prevNLSF_Q15), (pNLSF_Q15), (sizeof( psDec->prevNLSF_Q15 )));
 
 
     if( psDec->lossCnt ) {
@@ -11067,7 +13696,10 @@ void silk_decode_pulses(
 )
 {
     int i, j, k, iter, abs_q, nLS, RateLevelIndex;
-    int sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ], nLshifts[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ];
+    /* Narrowed to their value ranges (sum fits 16 + (nLS << 5) <= 336,
+       nLS <= 10) so both scratch arrays share a single cache line. */
+    opus_uint16 sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ];
+    opus_uint8 nLshifts[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ];
     opus_int16 *pulses_ptr;
     const opus_uint8 *cdf_ptr;
 
@@ -11088,16 +13720,24 @@ void silk_decode_pulses(
 
 
     cdf_ptr = silk_pulses_per_block_iCDF[ RateLevelIndex ];
-    for( i = 0; i < iter; i++ ) {
-        nLshifts[ i ] = 0;
-        sum_pulses[ i ] = ec_dec_icdf( psRangeDec, cdf_ptr, 8 );
+    {
+        /* Escape-row base hoisted once; the block state runs in scalars so
+           the arrays are only stored after each block settles, instead of
+           being re-indexed around every ec_dec_icdf call. */
+        const opus_uint8 *cdf_esc = silk_pulses_per_block_iCDF[ 10 - 1 ];
+        for( i = 0; i < iter; i++ ) {
+            int sp;
+            nLS = 0;
+            sp = ec_dec_icdf( psRangeDec, cdf_ptr, 8 );
 
 
-        while( sum_pulses[ i ] == 16 + 1 ) {
-            nLshifts[ i ]++;
+            while( sp == 16 + 1 ) {
+                nLS++;
 
-            sum_pulses[ i ] = ec_dec_icdf( psRangeDec,
-                    silk_pulses_per_block_iCDF[ 10 - 1] + ( nLshifts[ i ] == 10 ), 8 );
+                sp = ec_dec_icdf( psRangeDec, cdf_esc + ( nLS == 10 ), 8 );
+            }
+            nLshifts[ i ] = nLS;
+            sum_pulses[ i ] = sp;
         }
     }
 
@@ -11183,8 +13823,11 @@ void silk_decode_pitch(
     lag = min_lag + lagIndex;
 
     for( k = 0; k < nb_subfr; k++ ) {
-        pitch_lags[ k ] = lag + (*((Lag_CB_ptr) + ((k)*(cbk_size)+(contourIndex))));
-        pitch_lags[ k ] = ((min_lag) > (max_lag) ? ((pitch_lags[ k ]) > (min_lag) ? (min_lag) : ((pitch_lags[ k ]) < (max_lag) ? (max_lag) : (pitch_lags[ k ]))) : ((pitch_lags[ k ]) > (max_lag) ? (max_lag) : ((pitch_lags[ k ]) < (min_lag) ? (min_lag) : (pitch_lags[ k ]))));
+        /* min_lag = 2*Fs_kHz < max_lag = 18*Fs_kHz always holds, so the
+           swapped-limits arm of the full clamp is dead; the plain two-sided
+           form lowers to conditional moves. */
+        int l = lag + (*((Lag_CB_ptr) + ((k)*(cbk_size)+(contourIndex))));
+        pitch_lags[ k ] = l > max_lag ? max_lag : ( l < min_lag ? min_lag : l );
     }
 }
 int silk_decoder_set_fs(
@@ -11329,6 +13972,13 @@ typedef struct {
     int nChannelsAPI;
     int nChannelsInternal;
     int prev_decode_only_middle;
+    /* Persistent scratch for silk_Decode's staging buffers, replacing the
+       per-call allocas.  The two samplesOut1 copies are selected by
+       delay_stack_alloc and never live at the same time, so they share one
+       buffer; samplesOut2 holds one lane per API channel of at most 20 ms
+       resampled to 48 kHz. */
+    opus_int16 scratch_samplesOut1[ 2 * ( ( ( 5 * 4 ) * 16 ) + 2 ) ];
+    opus_int16 scratch_samplesOut2[ 2 * ( 3 * ( ( 5 * 4 ) * 16 ) ) ];
 } silk_decoder;
 
 
@@ -11475,9 +14125,12 @@ int silk_Decode(
                     channel_state[ n ].LBRR_flags[ 0 ] = 1;
                 } else {
                     LBRR_symbol = ec_dec_icdf( psRangeDec, silk_LBRR_flags_iCDF_ptr[ channel_state[ n ].nFramesPerPacket - 2 ], 8 ) + 1;
-                    for( i = 0; i < channel_state[ n ].nFramesPerPacket; i++ ) {
-                        channel_state[ n ].LBRR_flags[ i ] = ((LBRR_symbol)>>(i)) & 1;
-                    }
+                    /* Unconditional three-way fanout: the symbol for a
+                       2-frame packet is at most 3, so bit 2 is zero and
+                       matches the memset above. */
+                    channel_state[ n ].LBRR_flags[ 0 ] = LBRR_symbol & 1;
+                    channel_state[ n ].LBRR_flags[ 1 ] = ( LBRR_symbol >> 1 ) & 1;
+                    channel_state[ n ].LBRR_flags[ 2 ] = ( LBRR_symbol >> 2 ) & 1;
                 }
             }
         }
@@ -11547,9 +14200,7 @@ int silk_Decode(
 
     delay_stack_alloc = decControl->internalSampleRate*decControl->nChannelsInternal
           < decControl->API_sampleRate*decControl->nChannelsAPI;
-    opus_int16 *samplesOut1_tmp_storage1 = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*(delay_stack_alloc ? 1 : decControl->nChannelsInternal*(channel_state[ 0 ].frame_length + 2 )))
-
-                       ;
+    opus_int16 *samplesOut1_tmp_storage1 = psDec->scratch_samplesOut1;
     if ( delay_stack_alloc )
     {
        samplesOut1_tmp[ 0 ] = samplesOut;
@@ -11604,19 +14255,24 @@ int silk_Decode(
     *nSamplesOut = ((opus_int32)((nSamplesOutDec * decControl->API_sampleRate) / (((opus_int32)((opus_int16)(channel_state[ 0 ].fs_kHz)) * (opus_int32)((opus_int16)(1000))))));
 
 
-    opus_int16 *samplesOut2_tmp = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*(decControl->nChannelsAPI == 2 ? *nSamplesOut : 1))
-                                                                                  ;
+    opus_int16 *samplesOut2_tmp = psDec->scratch_samplesOut2;
     if( decControl->nChannelsAPI == 2 ) {
+        /* Each channel resamples into its own lane of the scratch and one
+           zip pass below interleaves them, instead of a strided scatter
+           after every resampler call. */
         resample_out_ptr = samplesOut2_tmp;
     } else {
         resample_out_ptr = samplesOut;
     }
 
-    opus_int16 *samplesOut1_tmp_storage2 = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*(delay_stack_alloc ? decControl->nChannelsInternal*(channel_state[ 0 ].frame_length + 2 ) : 1))
-
-
-                       ;
-    if ( delay_stack_alloc ) {
+    /* Same backing store as samplesOut1_tmp_storage1; only one of the two
+       is in use for a given delay_stack_alloc.  The move-aside copy is
+       only needed when the resampler output is samplesOut itself (mono API
+       upsampling would overrun its own input in place); with a stereo API
+       the resamplers write into the samplesOut2 lanes, which are disjoint
+       from the decoded data, so it can be read where it sits. */
+    opus_int16 *samplesOut1_tmp_storage2 = psDec->scratch_samplesOut1;
+    if ( delay_stack_alloc && decControl->nChannelsAPI != 2 ) {
        (memcpy((samplesOut1_tmp_storage2), (samplesOut), (decControl->nChannelsInternal*(channel_state[ 0 ].frame_length + 2))*sizeof(*(samplesOut1_tmp_storage2)) + 0*((samplesOut1_tmp_storage2)-(samplesOut)) ));
        samplesOut1_tmp[ 0 ] = samplesOut1_tmp_storage2;
        samplesOut1_tmp[ 1 ] = samplesOut1_tmp_storage2 + channel_state[ 0 ].frame_length + 2;
@@ -11624,14 +14280,7 @@ int silk_Decode(
     for( n = 0; n < (((decControl->nChannelsAPI) < (decControl->nChannelsInternal)) ? (decControl->nChannelsAPI) : (decControl->nChannelsInternal)); n++ ) {
 
 
-        ret += silk_resampler( &channel_state[ n ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ n ][ 1 ], nSamplesOutDec );
-
-
-        if( decControl->nChannelsAPI == 2 ) {
-            for( i = 0; i < *nSamplesOut; i++ ) {
-                samplesOut[ n + 2 * i ] = resample_out_ptr[ i ];
-            }
-        }
+        ret += silk_resampler( &channel_state[ n ].resampler_state, &resample_out_ptr[ n * 3 * ( ( 5 * 4 ) * 16 ) ], &samplesOut1_tmp[ n ][ 1 ], nSamplesOutDec );
     }
 
 
@@ -11639,15 +14288,34 @@ int silk_Decode(
         if ( stereo_to_mono ){
 
 
-            ret += silk_resampler( &channel_state[ 1 ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ 0 ][ 1 ], nSamplesOutDec );
-
-            for( i = 0; i < *nSamplesOut; i++ ) {
-                samplesOut[ 1 + 2 * i ] = resample_out_ptr[ i ];
-            }
+            ret += silk_resampler( &channel_state[ 1 ].resampler_state, &resample_out_ptr[ 3 * ( ( 5 * 4 ) * 16 ) ], &samplesOut1_tmp[ 0 ][ 1 ], nSamplesOutDec );
         } else {
-            for( i = 0; i < *nSamplesOut; i++ ) {
-                samplesOut[ 1 + 2 * i ] = samplesOut[ 0 + 2 * i ];
-            }
+            memcpy((&resample_out_ptr[ 3 * ( ( 5 * 4 ) * 16 ) ]), (resample_out_ptr), (*nSamplesOut * sizeof( opus_int16 )));
+        }
+    }
+
+    if( decControl->nChannelsAPI == 2 ) {
+        const opus_int16 *chL = samplesOut2_tmp;
+        const opus_int16 *chR = &samplesOut2_tmp[ 3 * ( ( 5 * 4 ) * 16 ) ];
+        i = 0;
+#if defined(DR_OPUS_SUPPORT_SSE2)
+        for( ; i + 8 <= *nSamplesOut; i += 8 ) {
+            __m128i l = _mm_loadu_si128( (const __m128i *)&chL[ i ] );
+            __m128i r = _mm_loadu_si128( (const __m128i *)&chR[ i ] );
+            _mm_storeu_si128( (__m128i *)&samplesOut[ 2 * i ], _mm_unpacklo_epi16( l, r ) );
+            _mm_storeu_si128( (__m128i *)&samplesOut[ 2 * i + 8 ], _mm_unpackhi_epi16( l, r ) );
+        }
+#elif defined(DR_OPUS_SUPPORT_NEON)
+        for( ; i + 8 <= *nSamplesOut; i += 8 ) {
+            int16x8x2_t v;
+            v.val[ 0 ] = vld1q_s16( &chL[ i ] );
+            v.val[ 1 ] = vld1q_s16( &chR[ i ] );
+            vst2q_s16( &samplesOut[ 2 * i ], v );
+        }
+#endif
+        for( ; i < *nSamplesOut; i++ ) {
+            samplesOut[ 2 * i ]     = chL[ i ];
+            samplesOut[ 2 * i + 1 ] = chR[ i ];
         }
     }
 
@@ -11686,7 +14354,31 @@ static inline void silk_CNG_exc(
     }
 
     seed = *rand_seed;
-    for( i = 0; i < length; i++ ) {
+    i = 0;
+    /* The LCG is a loop-carried multiply, so the plain loop is bound by
+       multiply latency.  Running four streams advanced by the recurrence
+       composed with itself four times -- A4 = A^4 and
+       B4 = B * (1 + A + A^2 + A^3) mod 2^32 -- produces the exact same
+       sequence while the four multiplies issue independently. */
+    if( length >= 4 ) {
+        opus_int32 s0, s1, s2, s3;
+        s0 = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((seed)) * (opus_uint32)((196314165))))));
+        s1 = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((s0)) * (opus_uint32)((196314165))))));
+        s2 = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((s1)) * (opus_uint32)((196314165))))));
+        s3 = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((s2)) * (opus_uint32)((196314165))))));
+        for( ; i + 4 <= length; i += 4 ) {
+            exc_Q14[ i     ] = exc_buf_Q14[ (int)( ((s0)>>(24)) & exc_mask ) ];
+            exc_Q14[ i + 1 ] = exc_buf_Q14[ (int)( ((s1)>>(24)) & exc_mask ) ];
+            exc_Q14[ i + 2 ] = exc_buf_Q14[ (int)( ((s2)>>(24)) & exc_mask ) ];
+            exc_Q14[ i + 3 ] = exc_buf_Q14[ (int)( ((s3)>>(24)) & exc_mask ) ];
+            seed = s3;
+            s0 = (((opus_int32)((opus_uint32)(((4143921812u))) + (opus_uint32)((opus_uint32)((s0)) * (opus_uint32)((2007447089))))));
+            s1 = (((opus_int32)((opus_uint32)(((4143921812u))) + (opus_uint32)((opus_uint32)((s1)) * (opus_uint32)((2007447089))))));
+            s2 = (((opus_int32)((opus_uint32)(((4143921812u))) + (opus_uint32)((opus_uint32)((s2)) * (opus_uint32)((2007447089))))));
+            s3 = (((opus_int32)((opus_uint32)(((4143921812u))) + (opus_uint32)((opus_uint32)((s3)) * (opus_uint32)((2007447089))))));
+        }
+    }
+    for( ; i < length; i++ ) {
         seed = (((opus_int32)((opus_uint32)(((907633515))) + (opus_uint32)((opus_uint32)((seed)) * (opus_uint32)((196314165))))));
         idx = (int)( ((seed)>>(24)) & exc_mask );
         ;
@@ -11811,10 +14503,10 @@ void silk_CNG(
             }
 
 
-            CNG_sig_Q14[ 16 + i ] = ((((opus_uint32)(CNG_sig_Q14[ 16 + i ]) + (opus_uint32)((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? ((((CNG_sig_Q14[ 16 + i ]) & ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) != 0 ? ((opus_int32)0x80000000) : (CNG_sig_Q14[ 16 + i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) : ((((CNG_sig_Q14[ 16 + i ]) | ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? 0x7FFFFFFF : (CNG_sig_Q14[ 16 + i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) );
+            CNG_sig_Q14[ 16 + i ] = silk_add_sat32( CNG_sig_Q14[ 16 + i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
 
 
-            frame[ i ] = (opus_int16)(opus_int16)(((((opus_int32)(frame[ i ])) + ((((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)))))))) > 0x7FFF ? 0x7FFF : (((((opus_int32)(frame[ i ])) + ((((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)))))))) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : ((((opus_int32)(frame[ i ])) + ((((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16))) >> ((8) - 1)) + 1) >> 1))))))))));
+            frame[ i ] = silk_sat16( (opus_int32)frame[ i ] + silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(CNG_sig_Q14[ 16 + i ]) * (gain_Q10)) >> 16), 8 ) ) );
 
         }
         memcpy((psCNG->CNG_synth_state), (&CNG_sig_Q14[ length ]), (16 * sizeof( opus_int32 )));
@@ -11863,7 +14555,7 @@ void silk_decode_signs(
     int length,
     const int signalType,
     const int quantOffsetType,
-    const int sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ]
+    const opus_uint16 sum_pulses[ ( ( ( 5 * 4 ) * 16 ) / 16 ) ]
 )
 {
     int i, j, p;
@@ -12221,11 +14913,11 @@ static inline void silk_PLC_conceal(
         }
 
 
-        sLPC_Q14_ptr[ 16 + i ] = ((((opus_uint32)(sLPC_Q14_ptr[ 16 + i ]) + (opus_uint32)((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? ((((sLPC_Q14_ptr[ 16 + i ]) & ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) != 0 ? ((opus_int32)0x80000000) : (sLPC_Q14_ptr[ 16 + i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) : ((((sLPC_Q14_ptr[ 16 + i ]) | ((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) & 0x80000000) == 0 ? 0x7FFFFFFF : (sLPC_Q14_ptr[ 16 + i ])+((((opus_int32)((opus_uint32)(((((((opus_int32)0x80000000))>>((4)))) > (((0x7FFFFFFF)>>((4)))) ? (((LPC_pred_Q10)) > (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : (((LPC_pred_Q10)) < (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : ((LPC_pred_Q10)))) : (((LPC_pred_Q10)) > (((0x7FFFFFFF)>>((4)))) ? (((0x7FFFFFFF)>>((4)))) : (((LPC_pred_Q10)) < (((((opus_int32)0x80000000))>>((4)))) ? (((((opus_int32)0x80000000))>>((4)))) : ((LPC_pred_Q10))))))<<((4))))))) )
-                                                                                 ;
+        sLPC_Q14_ptr[ 16 + i ] = silk_add_sat32( sLPC_Q14_ptr[ 16 + i ], silk_lshift_sat32_4( LPC_pred_Q10 ) );
 
 
-        frame[ i ] = (opus_int16)((((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1))))) > 0x7FFF ? 0x7FFF : ((((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1))))) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) > 0x7FFF ? 0x7FFF : ((((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)) < ((opus_int16)0x8000) ? ((opus_int16)0x8000) : (((8) == 1 ? ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> 1) + ((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) & 1) : (((((opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16))) >> ((8) - 1)) + 1) >> 1)))))));
+
+        frame[ i ] = silk_sat16( silk_rshift_round( (opus_int32)(((opus_int64)(sLPC_Q14_ptr[ 16 + i ]) * (prevGain_Q10[ 1 ])) >> 16), 8 ) );
     }
 
 
@@ -15773,7 +18465,11 @@ struct OpusDecoder {
    int decode_gain;
    int arch;
 
-
+   /* Bump-allocated scratch arena appended to the decoder allocation. Must
+      stay above stream_channels: OPUS_RESET_STATE memsets from there down. */
+   char *scratch;
+   opus_int32 scratch_size;
+   opus_int32 scratch_top;
 
    int stream_channels;
 
@@ -15789,6 +18485,26 @@ struct OpusDecoder {
 
    opus_uint32 rangeFinal;
 };
+/* Size of the per-decoder scratch arena. Covers the worst case per decode
+   call: the 46KB float staging buffer in opus_decode plus the per-frame
+   transition/redundancy buffers, including one level of transition
+   recursion. */
+#define OPUS_DECODE_SCRATCH_SIZE (64*1024)
+
+/* Scoped arena allocation (the pseudostack pattern from upstream's
+   stack_alloc.h): callers save the bump pointer on entry and restore it on
+   exit, so the transition recursion in opus_decode_frame and the nested
+   entry points unwind correctly. A request that does not fit falls back to
+   plain stack allocation. */
+#define OPUS_SCRATCH_SAVE(st)    opus_int32 _scratch_saved = (st)->scratch_top
+#define OPUS_SCRATCH_RESTORE(st) ((st)->scratch_top = _scratch_saved)
+#define OPUS_SCRATCH_ROUND(size) ((opus_int32)(((size)+15)&~(size_t)15))
+#define OPUS_SCRATCH_ALLOC(st, size) \
+   ((st)->scratch_top+OPUS_SCRATCH_ROUND(size) <= (st)->scratch_size ? \
+      ((st)->scratch_top += OPUS_SCRATCH_ROUND(size), \
+       (void*)((st)->scratch+(st)->scratch_top-OPUS_SCRATCH_ROUND(size))) : \
+      DR_OPUS_ALLOCA(size))
+
 int opus_decoder_get_size(int channels)
 {
    int silkDecSizeBytes, celtDecSizeBytes;
@@ -15800,7 +18516,8 @@ int opus_decoder_get_size(int channels)
       return 0;
    silkDecSizeBytes = align(silkDecSizeBytes);
    celtDecSizeBytes = celt_decoder_get_size(channels);
-   return align(sizeof(OpusDecoder))+silkDecSizeBytes+celtDecSizeBytes;
+   return align(sizeof(OpusDecoder))+silkDecSizeBytes+celtDecSizeBytes
+         +16+OPUS_DECODE_SCRATCH_SIZE;
 }
 
 int opus_decoder_init(OpusDecoder *st, opus_int32 Fs, int channels)
@@ -15824,6 +18541,10 @@ int opus_decoder_init(OpusDecoder *st, opus_int32 Fs, int channels)
    st->celt_dec_offset = st->silk_dec_offset+silkDecSizeBytes;
    silk_dec = (char*)st+st->silk_dec_offset;
    celt_dec = (OpusCustomDecoder*)((char*)st+st->celt_dec_offset);
+   st->scratch = (char*)st+st->celt_dec_offset+celt_decoder_get_size(channels);
+   st->scratch += (16-((size_t)st->scratch&15))&15;
+   st->scratch_size = OPUS_DECODE_SCRATCH_SIZE;
+   st->scratch_top = 0;
    st->stream_channels = st->channels = channels;
 
    st->Fs = Fs;
@@ -15915,8 +18636,21 @@ static int opus_packet_get_mode(const unsigned char *data)
    return mode;
 }
 
+static int opus_decode_frame_impl(OpusDecoder *st, const unsigned char *data,
+      opus_int32 len, opus_val16 *pcm, int frame_size, int decode_fec);
+
 static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
       opus_int32 len, opus_val16 *pcm, int frame_size, int decode_fec)
+{
+   int ret;
+   OPUS_SCRATCH_SAVE(st);
+   ret = opus_decode_frame_impl(st, data, len, pcm, frame_size, decode_fec);
+   OPUS_SCRATCH_RESTORE(st);
+   return ret;
+}
+
+static int opus_decode_frame_impl(OpusDecoder *st, const unsigned char *data,
+      opus_int32 len, opus_val16 *pcm, int frame_size, int decode_fec)
 {
    void *silk_dec;
    OpusCustomDecoder *celt_dec;
@@ -16046,7 +18780,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
       else
          pcm_transition_silk_size = F5*st->channels;
    }
-   opus_val16 *pcm_transition_celt = (opus_val16*)DR_OPUS_ALLOCA(sizeof(opus_val16)*(pcm_transition_celt_size));
+   opus_val16 *pcm_transition_celt = (opus_val16*)OPUS_SCRATCH_ALLOC(st, sizeof(opus_val16)*(pcm_transition_celt_size));
    if (transition && mode == 1002)
    {
       pcm_transition = pcm_transition_celt;
@@ -16065,7 +18799,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
 
 
    pcm_silk_size = (mode != 1002 && !celt_accum) ? ((F10) > (frame_size) ? (F10) : (frame_size))*st->channels : 1;
-   opus_int16 *pcm_silk = (opus_int16*)DR_OPUS_ALLOCA(sizeof(opus_int16)*(pcm_silk_size));
+   opus_int16 *pcm_silk = (opus_int16*)OPUS_SCRATCH_ALLOC(st, sizeof(opus_int16)*(pcm_silk_size));
 
 
    if (mode != 1002)
@@ -16173,7 +18907,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
       pcm_transition_silk_size=1;
    }
 
-   opus_val16 *pcm_transition_silk = (opus_val16*)DR_OPUS_ALLOCA(sizeof(opus_val16)*(pcm_transition_silk_size));
+   opus_val16 *pcm_transition_silk = (opus_val16*)OPUS_SCRATCH_ALLOC(st, sizeof(opus_val16)*(pcm_transition_silk_size));
 
    if (transition && mode != 1002)
    {
@@ -16213,7 +18947,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
 
 
    redundant_audio_size = redundancy ? F5*st->channels : 1;
-   opus_val16 *redundant_audio = (opus_val16*)DR_OPUS_ALLOCA(sizeof(opus_val16)*(redundant_audio_size));
+   opus_val16 *redundant_audio = (opus_val16*)OPUS_SCRATCH_ALLOC(st, sizeof(opus_val16)*(redundant_audio_size));
 
 
    if (redundancy && celt_to_silk)
@@ -16491,7 +19225,7 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
       opus_int32 len, opus_int16 *pcm, int frame_size, int decode_fec)
 {
    ;
-   int ret, i;
+   int ret;
    int nb_samples;
    ;
 
@@ -16501,8 +19235,8 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
       return -1;
    }
 
-   if (data != 
-              ((void *)0) 
+   if (data !=
+              ((void *)0)
                    && len > 0 && !decode_fec)
    {
       nb_samples = opus_decoder_get_nb_samples(st, data, len);
@@ -16512,17 +19246,16 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
          return -4;
    }
    ;
-   float *out = (float*)DR_OPUS_ALLOCA(sizeof(float)*(frame_size*st->channels));
+   OPUS_SCRATCH_SAVE(st);
+   float *out = (float*)OPUS_SCRATCH_ALLOC(st, sizeof(float)*(frame_size*st->channels));
 
    ret = opus_decode_native(st, data, len, out, frame_size, decode_fec, 0, 
                                                                           ((void *)0)
                                                                               , 1);
    if (ret > 0)
-   {
-      for (i=0;i<ret*st->channels;i++)
-         pcm[i] = FLOAT2INT16(out[i]);
-   }
+      celt_float2int16(out, pcm, ret*st->channels);
    ;
+   OPUS_SCRATCH_RESTORE(st);
    return ret;
 }
 
@@ -17701,14 +20434,44 @@ static void dr_opus__init_crc32(void) {
     dr_opus__crc32_initialized = DRLIBS_TRUE;
 }
 
-static drlibs_uint32 dr_opus__crc32(const drlibs_uint8* data, size_t len) {
-    drlibs_uint32 crc = 0;
+static drlibs_uint32 dr_opus__crc32_update(drlibs_uint32 crc, const drlibs_uint8* data, size_t len) {
     for (size_t i = 0; i < len; i++) {
         crc = (crc << 8) ^ dr_opus__crc32_table[((crc >> 24) ^ data[i]) & 0xFF];
     }
     return crc;
 }
 
+static drlibs_uint32 dr_opus__crc32(const drlibs_uint8* data, size_t len) {
+#if defined(DR_OPUS_SUPPORT_PCLMUL)
+    /* CLMUL 128-bit folding for the forward (MSB-first) Ogg polynomial. Each
+       iteration multiplies the accumulator by x^128 mod P and absorbs the next
+       16 message bytes: the high qword carries degrees 64..127 so it folds
+       with x^192 mod P, the low with x^128 mod P. The final reduction simply
+       runs the table CRC over the 16 accumulator bytes, which computes
+       acc*x^32 mod P exactly - no Barrett step needed. */
+    if (len >= 32) {
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i fold  = _mm_set_epi64x(0xC5B9CD4C /* x^192 mod P */, 0xE8A45605 /* x^128 mod P */);
+        drlibs_uint8 accBytes[16];
+
+        __m128i acc = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), bswap);
+        data += 16;
+        len  -= 16;
+        while (len >= 16) {
+            __m128i next = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), bswap);
+            acc = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc, fold, 0x11),
+                                              _mm_clmulepi64_si128(acc, fold, 0x00)), next);
+            data += 16;
+            len  -= 16;
+        }
+
+        _mm_storeu_si128((__m128i*)accBytes, _mm_shuffle_epi8(acc, bswap));
+        return dr_opus__crc32_update(dr_opus__crc32_update(0, accBytes, 16), data, len);
+    }
+#endif
+    return dr_opus__crc32_update(0, data, len);
+}
+
 /* File I/O */
 static size_t dr_opus__read(dr_opus* pOpus, void* pBuffer, size_t bytesToRead) {
     if (pOpus->pFile) {
@@ -17754,8 +20517,18 @@ static drlibs_bool32 dr_opus__read_ogg_page(dr_opus* pOpus) {
         pOpus->oggPageDataSize += pOpus->oggSegmentTable[i];
     }
     
-    if (dr_opus__read(pOpus, pOpus->oggPageBuffer, pOpus->oggPageDataSize) != pOpus->oggPageDataSize)
-        return DRLIBS_FALSE;
+    /* Memory sources don't need the staging copy - the payload is already
+       contiguous in the caller's buffer, so just point at it. */
+    if (pOpus->pMemory) {
+        if (pOpus->memorySize - pOpus->memoryPos < pOpus->oggPageDataSize)
+            return DRLIBS_FALSE;
+        pOpus->pOggPageData = pOpus->pMemory + pOpus->memoryPos;
+        pOpus->memoryPos += pOpus->oggPageDataSize;
+    } else {
+        if (dr_opus__read(pOpus, pOpus->pOggPageBuffer, pOpus->oggPageDataSize) != pOpus->oggPageDataSize)
+            return DRLIBS_FALSE;
+        pOpus->pOggPageData = pOpus->pOggPageBuffer;
+    }
     
     pOpus->oggPageDataPos = 0;
     pOpus->oggCurrentSegment = 0;
@@ -17774,7 +20547,7 @@ static drlibs_int32 dr_opus__read_packet(dr_opus* pOpus, drlibs_uint8* pBuffer,
         drlibs_uint8 segSize = pOpus->oggSegmentTable[pOpus->oggCurrentSegment++];
         
         if (packetSize + segSize > bufferSize) return -1;
-        memcpy(pBuffer + packetSize, pOpus->oggPageBuffer + pOpus->oggPageDataPos, segSize);
+        memcpy(pBuffer + packetSize, pOpus->pOggPageData + pOpus->oggPageDataPos, segSize);
         pOpus->oggPageDataPos += segSize;
         packetSize += segSize;
         
@@ -17826,16 +20599,19 @@ dr_opus_result dr_opus_init_file(const char* pFilePath, const dr_opus_allocation
     pOpus->pFile = fopen(pFilePath, "rb");
     if (!pOpus->pFile) return DR_OPUS_INVALID_FILE;
     
+    pOpus->pOggPageBuffer = (drlibs_uint8*)dr_opus__malloc(65307, pAlloc); /* Maximum Ogg page payload. */
+    if (!pOpus->pOggPageBuffer) { fclose(pOpus->pFile); return DR_OPUS_OUT_OF_MEMORY; }
+    
     /* Read Ogg/Opus headers */
-    if (!dr_opus__read_ogg_page(pOpus)) { fclose(pOpus->pFile); return DR_OPUS_INVALID_FILE; }
-    if (!dr_opus__read_opus_head(pOpus)) { fclose(pOpus->pFile); return DR_OPUS_INVALID_FILE; }
-    if (!dr_opus__read_ogg_page(pOpus)) { fclose(pOpus->pFile); return DR_OPUS_INVALID_FILE; }
-    if (!dr_opus__read_opus_tags(pOpus)) { fclose(pOpus->pFile); return DR_OPUS_INVALID_FILE; }
+    if (!dr_opus__read_ogg_page(pOpus)) { dr_opus_uninit(pOpus); return DR_OPUS_INVALID_FILE; }
+    if (!dr_opus__read_opus_head(pOpus)) { dr_opus_uninit(pOpus); return DR_OPUS_INVALID_FILE; }
+    if (!dr_opus__read_ogg_page(pOpus)) { dr_opus_uninit(pOpus); return DR_OPUS_INVALID_FILE; }
+    if (!dr_opus__read_opus_tags(pOpus)) { dr_opus_uninit(pOpus); return DR_OPUS_INVALID_FILE; }
     
     /* Create decoder */
     int err;
     pOpus->pOpusDecoder = opus_decoder_create(48000, pOpus->channels, &err);
-    if (!pOpus->pOpusDecoder) { fclose(pOpus->pFile); return DR_OPUS_ERROR; }
+    if (!pOpus->pOpusDecoder) { dr_opus_uninit(pOpus); return DR_OPUS_ERROR; }
     
     pOpus->preSkipRemaining = pOpus->preSkip;
     pOpus->oggHeadersRead = DRLIBS_TRUE;
@@ -17873,71 +20649,143 @@ dr_opus_result dr_opus_init_memory(const void* pData, size_t dataSize, const dr_
 void dr_opus_uninit(dr_opus* pOpus) {
     if (!pOpus) return;
     if (pOpus->pOpusDecoder) opus_decoder_destroy(pOpus->pOpusDecoder);
+    if (pOpus->pOggPageBuffer) dr_opus__free(pOpus->pOggPageBuffer, &pOpus->alloc);
+    if (pOpus->pDecodeBuffer) dr_opus__free(pOpus->pDecodeBuffer, &pOpus->alloc);
     if (pOpus->pFile) fclose((FILE*)pOpus->pFile);
     memset(pOpus, 0, sizeof(*pOpus));
 }
 
+/* The read loop is macro-expanded per channel count (Opus always decodes at
+   48kHz, so channels is the only runtime-variable dimension). With CHANNELS a
+   literal the frame<->sample multiplies fold to shifts and the staging memcpy
+   gets a compile-time element size. */
+#define DR_OPUS_READ_PCM_FRAMES_F32_IMPL(name, CHANNELS) \
+static drlibs_uint64 name(dr_opus* pOpus, drlibs_uint64 framesToRead, float* pBufferOut) { \
+    drlibs_uint64 framesRead = 0; \
+    \
+    while (framesRead < framesToRead) { \
+        /* Use buffered samples first */ \
+        if (pOpus->decodeBufferPos < pOpus->decodeBufferLen) { \
+            drlibs_uint32 toCopy = pOpus->decodeBufferLen - pOpus->decodeBufferPos; \
+            if (toCopy > framesToRead - framesRead) toCopy = (drlibs_uint32)(framesToRead - framesRead); \
+            \
+            if (pBufferOut) { \
+                memcpy(pBufferOut + framesRead * (CHANNELS), \
+                       pOpus->pDecodeBuffer + pOpus->decodeBufferPos * (CHANNELS), \
+                       toCopy * ((CHANNELS) * sizeof(float))); \
+            } \
+            pOpus->decodeBufferPos += toCopy; \
+            framesRead += toCopy; \
+            continue; \
+        } \
+        \
+        /* Decode next packet */ \
+        drlibs_uint8 packet[4096]; \
+        drlibs_int32 packetSize = dr_opus__read_packet(pOpus, packet, sizeof(packet)); \
+        if (packetSize <= 0) break; \
+        \
+        /* If the caller's buffer can hold the whole packet and there's no pre-skip \
+           pending, decode straight into it and skip the staging copy entirely. The \
+           packet's TOC byte tells us the exact sample count up front. */ \
+        int nbSamples = opus_packet_get_nb_samples(packet, packetSize, 48000); \
+        if (pBufferOut && pOpus->preSkipRemaining == 0 && \
+            nbSamples > 0 && (drlibs_uint64)nbSamples <= framesToRead - framesRead) { \
+            int samples = opus_decode_float(pOpus->pOpusDecoder, packet, packetSize, \
+                                            pBufferOut + framesRead * (CHANNELS), nbSamples, 0); \
+            if (samples <= 0) break; \
+            framesRead += samples; \
+            continue; \
+        } \
+        \
+        if (!pOpus->pDecodeBuffer) { \
+            pOpus->pDecodeBuffer = (float*)dr_opus__malloc(5760 * 2 * sizeof(float), &pOpus->alloc); \
+            if (!pOpus->pDecodeBuffer) break; \
+        } \
+        \
+        int samples = opus_decode_float(pOpus->pOpusDecoder, packet, packetSize, \
+                                        pOpus->pDecodeBuffer, 5760, 0); \
+        if (samples <= 0) break; \
+        \
+        /* Handle pre-skip */ \
+        drlibs_uint32 skip = 0; \
+        if (pOpus->preSkipRemaining > 0) { \
+            skip = (pOpus->preSkipRemaining > (drlibs_uint32)samples) ? samples : pOpus->preSkipRemaining; \
+            pOpus->preSkipRemaining -= skip; \
+        } \
+        \
+        pOpus->decodeBufferPos = skip; \
+        pOpus->decodeBufferLen = samples; \
+    } \
+    \
+    return framesRead; \
+}
+
+DR_OPUS_READ_PCM_FRAMES_F32_IMPL(dr_opus__read_pcm_frames_f32__mono,   1)
+DR_OPUS_READ_PCM_FRAMES_F32_IMPL(dr_opus__read_pcm_frames_f32__stereo, 2)
+
 drlibs_uint64 dr_opus_read_pcm_frames_f32(dr_opus* pOpus, drlibs_uint64 framesToRead, float* pBufferOut) {
     if (!pOpus || !pOpus->pOpusDecoder || framesToRead == 0) return 0;
     
-    drlibs_uint64 framesRead = 0;
-    
-    while (framesRead < framesToRead) {
-        /* Use buffered samples first */
-        if (pOpus->decodeBufferPos < pOpus->decodeBufferLen) {
-            drlibs_uint32 toCopy = pOpus->decodeBufferLen - pOpus->decodeBufferPos;
-            if (toCopy > framesToRead - framesRead) toCopy = (drlibs_uint32)(framesToRead - framesRead);
-            
-            if (pBufferOut) {
-                memcpy(pBufferOut + framesRead * pOpus->channels,
-                       pOpus->decodeBuffer + pOpus->decodeBufferPos * pOpus->channels,
-                       toCopy * pOpus->channels * sizeof(float));
-            }
-            pOpus->decodeBufferPos += toCopy;
-            framesRead += toCopy;
-            continue;
+    if (pOpus->channels == 2) {
+        return dr_opus__read_pcm_frames_f32__stereo(pOpus, framesToRead, pBufferOut);
+    }
+    return dr_opus__read_pcm_frames_f32__mono(pOpus, framesToRead, pBufferOut);
+}
+
+/* Converts float samples to clamped int16. Scaling and truncation match the
+   scalar path exactly: _mm_cvttps_epi32 truncates toward zero like the C cast
+   and the signed packs saturate like the explicit clamps. */
+static void dr_opus__f32_to_s16(const float* pIn, drlibs_int16* pOut, size_t count) {
+    size_t i = 0;
+#if defined(DR_OPUS_SUPPORT_AVX2)
+    {
+        const __m256 scale = _mm256_set1_ps(32767.0f);
+        for (; i + 16 <= count; i += 16) {
+            __m256i a = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(pIn + i),     scale));
+            __m256i b = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(pIn + i + 8), scale));
+            __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(pOut + i), p);
         }
-        
-        /* Decode next packet */
-        drlibs_uint8 packet[4096];
-        drlibs_int32 packetSize = dr_opus__read_packet(pOpus, packet, sizeof(packet));
-        if (packetSize <= 0) break;
-        
-        int samples = opus_decode_float(pOpus->pOpusDecoder, packet, packetSize, 
-                                        pOpus->decodeBuffer, 5760, 0);
-        if (samples <= 0) break;
-        
-        /* Handle pre-skip */
-        drlibs_uint32 skip = 0;
-        if (pOpus->preSkipRemaining > 0) {
-            skip = (pOpus->preSkipRemaining > (drlibs_uint32)samples) ? samples : pOpus->preSkipRemaining;
-            pOpus->preSkipRemaining -= skip;
+    }
+#elif defined(DR_OPUS_SUPPORT_SSE2)
+    {
+        const __m128 scale = _mm_set1_ps(32767.0f);
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pIn + i),     scale));
+            __m128i b = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(pIn + i + 4), scale));
+            _mm_storeu_si128((__m128i*)(pOut + i), _mm_packs_epi32(a, b));
         }
-        
-        pOpus->decodeBufferPos = skip;
-        pOpus->decodeBufferLen = samples;
     }
-    
-    return framesRead;
+#elif defined(DR_OPUS_SUPPORT_NEON)
+    {
+        const float32x4_t scale = vdupq_n_f32(32767.0f);
+        for (; i + 8 <= count; i += 8) {
+            int32x4_t a = vcvtq_s32_f32(vmulq_f32(vld1q_f32(pIn + i),     scale));
+            int32x4_t b = vcvtq_s32_f32(vmulq_f32(vld1q_f32(pIn + i + 4), scale));
+            vst1q_s16(pOut + i, vcombine_s16(vqmovn_s32(a), vqmovn_s32(b)));
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        float s = pIn[i] * 32767.0f;
+        if (s > 32767) s = 32767;
+        if (s < -32768) s = -32768;
+        pOut[i] = (drlibs_int16)s;
+    }
 }
 
 drlibs_uint64 dr_opus_read_pcm_frames_s16(dr_opus* pOpus, drlibs_uint64 framesToRead, drlibs_int16* pBufferOut) {
     float tempBuffer[1024];
     drlibs_uint64 framesRead = 0;
-    
+
     while (framesRead < framesToRead) {
         drlibs_uint64 toRead = framesToRead - framesRead;
         if (toRead > 1024 / pOpus->channels) toRead = 1024 / pOpus->channels;
-        
+
         drlibs_uint64 got = dr_opus_read_pcm_frames_f32(pOpus, toRead, tempBuffer);
         if (got == 0) break;
-        
-        for (drlibs_uint64 i = 0; i < got * pOpus->channels; i++) {
-            float s = tempBuffer[i] * 32767.0f;
-            if (s > 32767) s = 32767;
-            if (s < -32768) s = -32768;
-            pBufferOut[framesRead * pOpus->channels + i] = (drlibs_int16)s;
-        }
+
+        dr_opus__f32_to_s16(tempBuffer, pBufferOut + framesRead * pOpus->channels, (size_t)(got * pOpus->channels));
         framesRead += got;
     }
     return framesRead;
@@ -17984,12 +20832,7 @@ drlibs_int16* dr_opus_open_file_and_read_pcm_frames_s16(const char* pFilePath, i
     if (!f) return NULL;
     
     drlibs_int16* s = (drlibs_int16*)dr_opus__malloc(frames * ch * sizeof(drlibs_int16), pAlloc);
-    for (drlibs_uint64 i = 0; i < frames * ch; i++) {
-        float v = f[i] * 32767.0f;
-        if (v > 32767) v = 32767;
-        if (v < -32768) v = -32768;
-        s[i] = (drlibs_int16)v;
-    }
+    dr_opus__f32_to_s16(f, s, (size_t)(frames * ch));
     dr_opus__free(f, pAlloc);
     
     if (pChannels) *pChannels = ch;
@@ -18033,12 +20876,7 @@ drlibs_int16* dr_opus_open_memory_and_read_pcm_frames_s16(const void* pData, siz
     if (!f) return NULL;
     
     drlibs_int16* s = (drlibs_int16*)dr_opus__malloc(frames * ch * sizeof(drlibs_int16), pAlloc);
-    for (drlibs_uint64 i = 0; i < frames * ch; i++) {
-        float v = f[i] * 32767.0f;
-        if (v > 32767) v = 32767;
-        if (v < -32768) v = -32768;
-        s[i] = (drlibs_int16)v;
-    }
+    dr_opus__f32_to_s16(f, s, (size_t)(frames * ch));
     dr_opus__free(f, pAlloc);
     
     if (pChannels) *pChannels = ch;